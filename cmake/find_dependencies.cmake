@@ -2,3 +2,6 @@ find_package(Boost 1.61.0 REQUIRED)
 find_package(type_safe REQUIRED)
 find_package(jegp 3.1.0 REQUIRED)
 find_package(RapidXml 5.0.0 REQUIRED)
+find_package(ZLIB REQUIRED)
+find_package(zstd QUIET)
+find_package(Threads REQUIRED)
@@ -13,6 +13,7 @@
 #include <tmxpp/Image_layer.hpp>
 #include <tmxpp/Layer.hpp>
 #include <tmxpp/Map.hpp>
+#include <tmxpp/Map_view.hpp>
 #include <tmxpp/Object.hpp>
 #include <tmxpp/Object_layer.hpp>
 #include <tmxpp/Offset.hpp>
@@ -20,12 +21,17 @@
 #include <tmxpp/Point.hpp>
 #include <tmxpp/Properties.hpp>
 #include <tmxpp/Property.hpp>
+#include <tmxpp/Reader.hpp>
 #include <tmxpp/Size.hpp>
 #include <tmxpp/Tile_id.hpp>
 #include <tmxpp/Tile_layer.hpp>
 #include <tmxpp/Tile_set.hpp>
+#include <tmxpp/Tmx_view.hpp>
+#include <tmxpp/Tsx_cache.hpp>
 #include <tmxpp/Unique_id.hpp>
 #include <tmxpp/Unit_interval.hpp>
+#include <tmxpp/binary.hpp>
+#include <tmxpp/hash.hpp>
 #include <tmxpp/read.hpp>
 #include <tmxpp/write.hpp>
 
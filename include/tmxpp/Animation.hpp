@@ -1,12 +1,13 @@
 #ifndef TMXPP_ANIMATION_HPP
 #define TMXPP_ANIMATION_HPP
 
+#include <memory_resource>
 #include <vector>
 #include <tmxpp/Frame.hpp>
 
 namespace tmxpp {
 
-using Animation = std::vector<Frame>;
+using Animation = std::pmr::vector<Frame>;
 
 } // namespace tmxpp
 
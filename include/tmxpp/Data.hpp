@@ -1,8 +1,18 @@
 #ifndef TMXPP_DATA_HPP
 #define TMXPP_DATA_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include <tmxpp/Flip.hpp>
 #include <tmxpp/Tile_id.hpp>
 #include <tmxpp/exceptions.hpp>
 
@@ -10,7 +20,7 @@ namespace tmxpp {
 
 struct Data {
     enum class Encoding : unsigned char { csv, base64 };
-    enum class Compression : unsigned char { none, zlib };
+    enum class Compression : unsigned char { none, zlib, gzip, zstd };
 
     class Format {
     public:
@@ -53,7 +63,412 @@ struct Data {
         Compression compression_;
     };
 
-    using Flipped_ids = std::vector<std::optional<Flipped_tile_id>>;
+    // A sequence of `std::optional<Flipped_tile_id>` packed as the 32-bit raw
+    // tile ids of the TMX format.
+    class Flipped_ids {
+    public:
+        using raw_type        = std::uint_least32_t;
+        using value_type      = std::optional<Flipped_tile_id>;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = value_type;
+        using Decoder         = std::function<std::vector<raw_type>()>;
+
+        class reference {
+        public:
+            reference(const reference&) = default;
+
+            reference& operator=(value_type id) noexcept
+            {
+                *raw_ = to_raw(id);
+                return *this;
+            }
+            reference& operator=(const reference& r) noexcept
+            {
+                return *this = value_type{r};
+            }
+
+            [[implicit]] operator value_type() const noexcept
+            {
+                return to_flipped(*raw_);
+            }
+
+        private:
+            explicit reference(raw_type* raw) noexcept : raw_{raw}
+            {
+            }
+
+            raw_type* raw_;
+
+            friend Flipped_ids;
+        };
+
+        // A proxy iterator with the operations of a random-access iterator.
+        // It is only an input iterator, as it dereferences to a prvalue.
+        template <bool Const>
+        class basic_iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = Flipped_ids::value_type;
+            using difference_type   = Flipped_ids::difference_type;
+            using reference         = std::conditional_t<
+                Const, Flipped_ids::const_reference, Flipped_ids::reference>;
+            using pointer = void;
+
+            basic_iterator() = default;
+
+            template <bool C = Const, class = std::enable_if_t<C>>
+            basic_iterator(basic_iterator<false> i) noexcept : raw_{i.raw_}
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return (*this)[0];
+            }
+            reference operator[](difference_type n) const noexcept
+            {
+                if constexpr (Const)
+                    return to_flipped(raw_[n]);
+                else
+                    return reference{raw_ + n};
+            }
+
+            basic_iterator& operator++() noexcept
+            {
+                ++raw_;
+                return *this;
+            }
+            basic_iterator operator++(int) noexcept
+            {
+                return basic_iterator{raw_++};
+            }
+            basic_iterator& operator--() noexcept
+            {
+                --raw_;
+                return *this;
+            }
+            basic_iterator operator--(int) noexcept
+            {
+                return basic_iterator{raw_--};
+            }
+
+            basic_iterator& operator+=(difference_type n) noexcept
+            {
+                raw_ += n;
+                return *this;
+            }
+            basic_iterator& operator-=(difference_type n) noexcept
+            {
+                raw_ -= n;
+                return *this;
+            }
+
+            friend basic_iterator operator+(
+                basic_iterator i, difference_type n) noexcept
+            {
+                return i += n;
+            }
+            friend basic_iterator operator+(
+                difference_type n, basic_iterator i) noexcept
+            {
+                return i += n;
+            }
+            friend basic_iterator operator-(
+                basic_iterator i, difference_type n) noexcept
+            {
+                return i -= n;
+            }
+            friend difference_type operator-(
+                basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ - r.raw_;
+            }
+
+            friend bool operator==(basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ == r.raw_;
+            }
+            friend bool operator!=(basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ != r.raw_;
+            }
+            friend bool operator<(basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ < r.raw_;
+            }
+            friend bool operator>(basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ > r.raw_;
+            }
+            friend bool operator<=(basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ <= r.raw_;
+            }
+            friend bool operator>=(basic_iterator l, basic_iterator r) noexcept
+            {
+                return l.raw_ >= r.raw_;
+            }
+
+        private:
+            using Raw_pointer =
+                std::conditional_t<Const, const raw_type*, raw_type*>;
+
+            explicit basic_iterator(Raw_pointer raw) noexcept : raw_{raw}
+            {
+            }
+
+            Raw_pointer raw_{};
+
+            friend Flipped_ids;
+            friend basic_iterator<true>;
+        };
+
+        using iterator       = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        Flipped_ids() = default;
+
+        Flipped_ids(std::initializer_list<value_type> ids)
+          : Flipped_ids(ids.begin(), ids.end())
+        {
+        }
+
+        template <
+            class InputIterator,
+            class = typename std::iterator_traits<
+                InputIterator>::iterator_category>
+        Flipped_ids(InputIterator first, InputIterator last)
+        {
+            assign(first, last);
+        }
+
+        // Throws: `Invalid_argument` if `!is_valid(id)` for any `id` in `raw`.
+        explicit Flipped_ids(std::vector<raw_type> raw) : raw_{std::move(raw)}
+        {
+            // Not short-circuiting lets the loop vectorize.
+            bool valid{true};
+            for (auto id : raw_)
+                valid &= is_valid(id);
+
+            if (!valid)
+                throw Invalid_argument{"Invalid raw tile id."};
+        }
+
+        // Effects: Defers the raw tile ids to their first access, which
+        //          initializes them as if by `Flipped_ids(decode())`.
+        // Notes: Copies share the deferred raw tile ids, whose initialization
+        //        is thread-safe. Modifiers initialize them first.
+        explicit Flipped_ids(Decoder decode)
+          : deferred_{std::make_shared<Deferred>(std::move(decode))}
+        {
+        }
+
+        template <
+            class InputIterator,
+            class = typename std::iterator_traits<
+                InputIterator>::iterator_category>
+        void assign(InputIterator first, InputIterator last)
+        {
+            clear();
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+
+        iterator begin()
+        {
+            return iterator{owned().data()};
+        }
+        iterator end()
+        {
+            return iterator{owned().data() + raw_.size()};
+        }
+        const_iterator begin() const
+        {
+            return const_iterator{raw().data()};
+        }
+        const_iterator end() const
+        {
+            return const_iterator{raw().data() + raw().size()};
+        }
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        bool empty() const
+        {
+            return raw().empty();
+        }
+        size_type size() const
+        {
+            return raw().size();
+        }
+        size_type max_size() const noexcept
+        {
+            return raw_.max_size();
+        }
+        size_type capacity() const
+        {
+            return raw().capacity();
+        }
+        void reserve(size_type n)
+        {
+            owned().reserve(n);
+        }
+
+        reference operator[](size_type i)
+        {
+            return reference{&owned()[i]};
+        }
+        const_reference operator[](size_type i) const
+        {
+            return to_flipped(raw()[i]);
+        }
+
+        reference front()
+        {
+            return *begin();
+        }
+        const_reference front() const
+        {
+            return *begin();
+        }
+        reference back()
+        {
+            return *(end() - 1);
+        }
+        const_reference back() const
+        {
+            return *(end() - 1);
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args)
+        {
+            push_back(value_type(std::forward<Args>(args)...));
+            return back();
+        }
+        void push_back(value_type id)
+        {
+            owned().push_back(to_raw(id));
+        }
+        void pop_back()
+        {
+            owned().pop_back();
+        }
+        iterator insert(const_iterator pos, value_type id)
+        {
+            const auto i{pos - cbegin()};
+            owned().insert(raw_.begin() + i, to_raw(id));
+            return begin() + i;
+        }
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            const auto i{first - cbegin()};
+            const auto n{last - first};
+            owned().erase(raw_.begin() + i, raw_.begin() + i + n);
+            return begin() + i;
+        }
+        void resize(size_type n)
+        {
+            owned().resize(n);
+        }
+        void clear() noexcept
+        {
+            deferred_.reset();
+            raw_.clear();
+        }
+
+        // Returns: The raw tile ids, in the native byte order.
+        // Throws: Any exception thrown by initializing deferred raw tile ids.
+        const std::vector<raw_type>& raw() const
+        {
+            return deferred_ ? deferred_->raw() : raw_;
+        }
+
+        // Returns: `true` if `id` is a valid raw tile id, and `false`
+        //          otherwise.
+        // Notes: `0` is the raw tile id of the empty tile.
+        static constexpr bool is_valid(raw_type id) noexcept
+        {
+            return id == 0 || (id & global_mask) != 0;
+        }
+
+        // Requires: `is_valid(id)`.
+        static value_type to_flipped(raw_type id) noexcept
+        {
+            if (id == 0)
+                return {};
+            return Flipped_tile_id{
+                static_cast<Flip>(id >> first_flip_bit),
+                Global_tile_id{static_cast<std::int_least32_t>(
+                    id & global_mask)}};
+        }
+
+        static raw_type to_raw(value_type id) noexcept
+        {
+            if (!id)
+                return 0;
+            return static_cast<raw_type>(id->flip) << first_flip_bit |
+                   static_cast<raw_type>(*id->id);
+        }
+
+        friend bool operator==(const Flipped_ids& l, const Flipped_ids& r)
+        {
+            return l.raw() == r.raw();
+        }
+        friend bool operator!=(const Flipped_ids& l, const Flipped_ids& r)
+        {
+            return !(l == r);
+        }
+
+    private:
+        static constexpr raw_type global_mask{0x1FFF'FFFF};
+        static constexpr int first_flip_bit{29};
+
+        class Deferred {
+        public:
+            explicit Deferred(Decoder decode) : decode_{std::move(decode)}
+            {
+            }
+
+            const std::vector<raw_type>& raw() const
+            {
+                std::call_once(initialized_, [this] {
+                    raw_ = Flipped_ids(decode_()).raw_;
+                    decode_ = nullptr;
+                });
+                return raw_;
+            }
+
+        private:
+            mutable std::once_flag initialized_;
+            mutable Decoder decode_;
+            mutable std::vector<raw_type> raw_;
+        };
+
+        // Returns: The raw tile ids, no longer shared.
+        std::vector<raw_type>& owned()
+        {
+            if (deferred_) {
+                raw_ = deferred_->raw();
+                deferred_.reset();
+            }
+            return raw_;
+        }
+
+        std::vector<raw_type> raw_;
+        std::shared_ptr<const Deferred> deferred_;
+    };
 
     Format format;
     Flipped_ids ids;
@@ -68,11 +483,11 @@ constexpr bool operator!=(Data::Format l, Data::Format r) noexcept
     return !(l == r);
 }
 
-inline bool operator==(const Data& l, const Data& r) noexcept
+inline bool operator==(const Data& l, const Data& r)
 {
     return l.format == r.format && l.ids == r.ids;
 }
-inline bool operator!=(const Data& l, const Data& r) noexcept
+inline bool operator!=(const Data& l, const Data& r)
 {
     return !(l == r);
 }
@@ -2,11 +2,16 @@
 #define TMXPP_FILE_HPP
 
 #include <experimental/filesystem>
+#include <string_view>
+#include <tmxpp/Strong_typedef.hpp>
 
 namespace tmxpp {
 
 using File = std::experimental::filesystem::path;
 
+// The name of a file, viewed.
+using File_view = Strong_typedef<std::string_view, struct _file_view>;
+
 } // namespace tmxpp
 
 #endif // TMXPP_FILE_HPP
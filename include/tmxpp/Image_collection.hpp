@@ -1,6 +1,7 @@
 #ifndef TMXPP_IMAGE_COLLECTION_HPP
 #define TMXPP_IMAGE_COLLECTION_HPP
 
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -25,11 +26,11 @@ struct Image_collection {
         Animation animation;
     };
 
-    using Tiles = std::vector<Tile>;
+    using Tiles = std::pmr::vector<Tile>;
 
     Global_tile_id first_id;
     File tsx;
-    std::string name;
+    std::pmr::string name;
     pxSize max_tile_size;
     Non_negative<int> tile_count;
     Non_negative<int> columns;
@@ -1,6 +1,7 @@
 #ifndef TMXPP_LAYER_HPP
 #define TMXPP_LAYER_HPP
 
+#include <memory_resource>
 #include <string>
 #include <tmxpp/Offset.hpp>
 #include <tmxpp/Properties.hpp>
@@ -9,7 +10,7 @@
 namespace tmxpp {
 
 struct Layer {
-    std::string name;
+    std::pmr::string name;
     Unit_interval opacity;
     bool visible;
     Offset offset;
@@ -1,6 +1,7 @@
 #ifndef TMXPP_MAP_HPP
 #define TMXPP_MAP_HPP
 
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <variant>
@@ -44,12 +45,12 @@ struct Map {
     };
 
     using Tile_set  = std::variant<tmxpp::Tile_set, Image_collection>;
-    using Tile_sets = std::vector<Tile_set>;
+    using Tile_sets = std::pmr::vector<Tile_set>;
 
     using Layer  = std::variant<Tile_layer, Object_layer, Image_layer>;
-    using Layers = std::vector<Layer>;
+    using Layers = std::pmr::vector<Layer>;
 
-    std::string version;
+    std::pmr::string version;
     Orientation orientation;
     Render_order render_order;
     iSize size;
@@ -98,7 +99,7 @@ constexpr bool operator!=(Map::Hexagonal l, Map::Hexagonal r) noexcept
     return !(l == r);
 }
 
-inline bool operator==(const Map& l, const Map& r) noexcept
+inline bool operator==(const Map& l, const Map& r)
 {
     return l.version == r.version && l.orientation == r.orientation &&
            l.render_order == r.render_order && l.size == r.size &&
@@ -107,7 +108,7 @@ inline bool operator==(const Map& l, const Map& r) noexcept
            l.properties == r.properties && l.tile_sets == r.tile_sets &&
            l.layers == r.layers;
 }
-inline bool operator!=(const Map& l, const Map& r) noexcept
+inline bool operator!=(const Map& l, const Map& r)
 {
     return !(l == r);
 }
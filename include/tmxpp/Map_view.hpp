@@ -0,0 +1,604 @@
+#ifndef TMXPP_MAP_VIEW_HPP
+#define TMXPP_MAP_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <experimental/filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <variant>
+#include <tmxpp/Color.hpp>
+#include <tmxpp/Data.hpp>
+#include <tmxpp/Degrees.hpp>
+#include <tmxpp/File.hpp>
+#include <tmxpp/Frame.hpp>
+#include <tmxpp/Map.hpp>
+#include <tmxpp/Object.hpp>
+#include <tmxpp/Object_layer.hpp>
+#include <tmxpp/Offset.hpp>
+#include <tmxpp/Point.hpp>
+#include <tmxpp/Size.hpp>
+#include <tmxpp/Tile_id.hpp>
+#include <tmxpp/Unique_id.hpp>
+#include <tmxpp/Unit_interval.hpp>
+#include <tmxpp/exceptions.hpp>
+
+namespace tmxpp {
+
+namespace impl {
+
+// The sections of a binary TMX.
+struct Binary_sections {
+    std::string_view strings;
+    std::string_view records;
+    std::string_view tile_ids;
+};
+
+struct Binary_view_access;
+
+// Returns: The `T` of the record at `record`.
+template <class T>
+T binary_element(const Binary_sections& sections, const char* record);
+
+class Mapped_file;
+
+} // namespace impl
+
+// A read-only, random-access range of the elements of an array of a binary
+// TMX, which are read on access.
+template <class T>
+class Array_view {
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T;
+
+    // A proxy iterator with the operations of a random-access iterator.
+    // It is only an input iterator, as it dereferences to a prvalue.
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = T;
+        using difference_type   = Array_view::difference_type;
+        using reference         = T;
+        using pointer           = void;
+
+        iterator() = default;
+
+        reference operator*() const
+        {
+            return impl::binary_element<T>(sections_, record_);
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        iterator& operator++() noexcept
+        {
+            record_ += stride_;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto i{*this};
+            ++*this;
+            return i;
+        }
+
+        iterator& operator--() noexcept
+        {
+            record_ -= stride_;
+            return *this;
+        }
+
+        iterator operator--(int) noexcept
+        {
+            auto i{*this};
+            --*this;
+            return i;
+        }
+
+        iterator& operator+=(difference_type n) noexcept
+        {
+            record_ += n * static_cast<difference_type>(stride_);
+            return *this;
+        }
+
+        iterator& operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        friend iterator operator+(iterator i, difference_type n) noexcept
+        {
+            return i += n;
+        }
+
+        friend iterator operator+(difference_type n, iterator i) noexcept
+        {
+            return i += n;
+        }
+
+        friend iterator operator-(iterator i, difference_type n) noexcept
+        {
+            return i -= n;
+        }
+
+        friend difference_type operator-(iterator l, iterator r) noexcept
+        {
+            return (l.record_ - r.record_) /
+                   static_cast<difference_type>(l.stride_);
+        }
+
+        friend bool operator==(iterator l, iterator r) noexcept
+        {
+            return l.record_ == r.record_;
+        }
+
+        friend bool operator!=(iterator l, iterator r) noexcept
+        {
+            return l.record_ != r.record_;
+        }
+
+        friend bool operator<(iterator l, iterator r) noexcept
+        {
+            return l.record_ < r.record_;
+        }
+
+        friend bool operator>(iterator l, iterator r) noexcept
+        {
+            return l.record_ > r.record_;
+        }
+
+        friend bool operator<=(iterator l, iterator r) noexcept
+        {
+            return l.record_ <= r.record_;
+        }
+
+        friend bool operator>=(iterator l, iterator r) noexcept
+        {
+            return l.record_ >= r.record_;
+        }
+
+    private:
+        iterator(
+            const impl::Binary_sections& sections, const char* record,
+            size_type stride) noexcept
+          : sections_{sections}, record_{record}, stride_{stride}
+        {
+        }
+
+        impl::Binary_sections sections_;
+        const char* record_{};
+        size_type stride_{1};
+
+        friend Array_view;
+    };
+
+    using const_iterator = iterator;
+
+    Array_view() = default;
+
+    iterator begin() const noexcept
+    {
+        return iterator{sections_, first_, stride_};
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator{sections_, first_ + size_ * stride_, stride_};
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    // Requires: `i < size()`.
+    reference operator[](size_type i) const
+    {
+        return begin()[static_cast<difference_type>(i)];
+    }
+
+private:
+    Array_view(
+        const impl::Binary_sections& sections, const char* first,
+        size_type size, size_type stride) noexcept
+      : sections_{sections}, first_{first}, size_{size}, stride_{stride}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* first_{};
+    size_type size_{};
+    size_type stride_{1};
+
+    friend impl::Binary_view_access;
+};
+
+// A read-only, random-access range of the tile ids of a tile layer of a binary
+// TMX.
+class Tile_ids_view {
+public:
+    using raw_type        = Data::Flipped_ids::raw_type;
+    using value_type      = Data::Flipped_ids::value_type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    Tile_ids_view() = default;
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    // Requires: `i < size()`.
+    // Returns: The `i`th raw tile id, in the native byte order.
+    raw_type raw(size_type i) const noexcept
+    {
+        raw_type id;
+        std::memcpy(&id, first_ + i * sizeof(id), sizeof(id));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        id = __builtin_bswap32(id);
+#endif
+        return id;
+    }
+
+    // Requires: `i < size()`.
+    // Returns: The `i`th tile id.
+    // Throws: `Invalid_argument` if the raw tile id is invalid.
+    value_type operator[](size_type i) const
+    {
+        const auto id{raw(i)};
+
+        if (!Data::Flipped_ids::is_valid(id))
+            throw Invalid_argument{"Invalid raw tile id."};
+
+        return Data::Flipped_ids::to_flipped(id);
+    }
+
+    // Returns: The `Data::Flipped_ids` with the tile ids of `*this`.
+    Data::Flipped_ids to_flipped_ids() const;
+
+private:
+    Tile_ids_view(const char* first, size_type size) noexcept
+      : first_{first}, size_{size}
+    {
+    }
+
+    const char* first_{};
+    size_type size_{};
+
+    friend impl::Binary_view_access;
+};
+
+class Property_view {
+public:
+    using Value = std::variant<
+        std::string_view, int, double, bool, Color, File_view>;
+
+    std::string_view name() const;
+    Value value() const;
+
+private:
+    Property_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+
+    friend impl::Binary_view_access;
+};
+
+using Properties_view = Array_view<Property_view>;
+
+class Image_view {
+public:
+    std::string_view source() const;
+    std::optional<Color> transparent() const;
+    std::optional<pxSize> size() const;
+
+private:
+    Image_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+
+    friend impl::Binary_view_access;
+};
+
+class Object_view {
+public:
+    struct Polygon {
+        using Points = Array_view<Point>;
+
+        Points points;
+    };
+
+    struct Polyline {
+        using Points = Polygon::Points;
+
+        Points points;
+    };
+
+    using Shape = std::variant<
+        Object::Rectangle, Object::Ellipse, Polygon, Polyline>;
+
+    Unique_id unique_id() const;
+    std::string_view name() const;
+    std::string_view type() const;
+    Point position() const;
+    std::optional<Shape> shape() const;
+    Degrees clockwise_rotation() const;
+    std::optional<Global_tile_id> global_id() const;
+    bool visible() const;
+    Properties_view properties() const;
+
+private:
+    Object_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+
+    friend impl::Binary_view_access;
+};
+
+class Layer_view {
+public:
+    std::string_view name() const;
+    Unit_interval opacity() const;
+    bool visible() const;
+    Offset offset() const;
+    Properties_view properties() const;
+
+protected:
+    Layer_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+};
+
+class Tile_layer_view : public Layer_view {
+public:
+    iSize size() const;
+    Data::Format format() const;
+    // Returns: The `size().w * size().h` tile ids.
+    // Throws: `Exception` if the count of tile ids does not match the size.
+    Tile_ids_view tile_ids() const;
+
+private:
+    using Layer_view::Layer_view;
+
+    friend impl::Binary_view_access;
+};
+
+class Object_layer_view : public Layer_view {
+public:
+    using Objects = Array_view<Object_view>;
+
+    std::optional<Color> color() const;
+    Object_layer::Draw_order draw_order() const;
+    Objects objects() const;
+
+private:
+    using Layer_view::Layer_view;
+
+    friend impl::Binary_view_access;
+};
+
+class Image_layer_view : public Layer_view {
+public:
+    std::optional<Image_view> image() const;
+
+private:
+    using Layer_view::Layer_view;
+
+    friend impl::Binary_view_access;
+};
+
+class Tile_view {
+public:
+    Local_tile_id id() const;
+    Properties_view properties() const;
+    std::optional<Object_layer_view> collision_shape() const;
+    Array_view<Frame> animation() const;
+
+protected:
+    Tile_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+
+    friend impl::Binary_view_access;
+};
+
+class Image_collection_tile_view : public Tile_view {
+public:
+    Image_view image() const;
+
+private:
+    using Tile_view::Tile_view;
+
+    friend impl::Binary_view_access;
+};
+
+class Tile_set_view {
+public:
+    using Tiles = Array_view<Tile_view>;
+
+    Global_tile_id first_id() const;
+    std::string_view tsx() const;
+    std::string_view name() const;
+    pxSize tile_size() const;
+    Non_negative<Pixels> spacing() const;
+    Non_negative<Pixels> margin() const;
+    iSize size() const;
+    Offset tile_offset() const;
+    Properties_view properties() const;
+    Image_view image() const;
+    Tiles tiles() const;
+
+private:
+    Tile_set_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+
+    friend impl::Binary_view_access;
+};
+
+class Image_collection_view {
+public:
+    using Tiles = Array_view<Image_collection_tile_view>;
+
+    Global_tile_id first_id() const;
+    std::string_view tsx() const;
+    std::string_view name() const;
+    pxSize max_tile_size() const;
+    Non_negative<int> tile_count() const;
+    Non_negative<int> columns() const;
+    Offset tile_offset() const;
+    Properties_view properties() const;
+    Tiles tiles() const;
+
+private:
+    Image_collection_view(
+        const impl::Binary_sections& sections, const char* record) noexcept
+      : sections_{sections}, record_{record}
+    {
+    }
+
+    impl::Binary_sections sections_;
+    const char* record_;
+
+    friend impl::Binary_view_access;
+};
+
+// A read-only view of the `Map` of a binary TMX, which reads the binary TMX in
+// place on access.
+// A view, and the views obtained from it, are valid as long as the memory of
+// the binary TMX is. Their accessors throw `Exception` if the part of the
+// binary TMX they read is invalid.
+class Map_view {
+public:
+    using Tile_set  = std::variant<Tile_set_view, Image_collection_view>;
+    using Tile_sets = Array_view<Tile_set>;
+
+    using Layer =
+        std::variant<Tile_layer_view, Object_layer_view, Image_layer_view>;
+    using Layers = Array_view<Layer>;
+
+    // Effects: Constructs a view of the `Map` of the binary TMX `binary`.
+    // Throws: `Exception` if `binary` is not a binary TMX of the supported
+    //         version.
+    explicit Map_view(std::string_view binary);
+
+    std::string_view version() const;
+    Map::Orientation orientation() const;
+    Map::Render_order render_order() const;
+    iSize size() const;
+    pxSize general_tile_size() const;
+    std::optional<Color> background() const;
+    Unique_id next_id() const;
+    Properties_view properties() const;
+    Tile_sets tile_sets() const;
+    Layers layers() const;
+
+private:
+    impl::Binary_sections sections_;
+    const char* record_;
+};
+
+// A binary TMX file mapped into memory, shared with other mappings of the file
+// until written.
+class Map_file {
+public:
+    // Effects: Maps the binary TMX `path`.
+    // Throws: `Exception` if the file could not be mapped, or is not a binary
+    //         TMX of the supported version.
+    explicit Map_file(const std::experimental::filesystem::path& path);
+
+    Map_file(Map_file&&) noexcept;
+    Map_file& operator=(Map_file&&) noexcept;
+
+    ~Map_file();
+
+    // Returns: A view of the `Map` of the file, valid as long as `*this` is.
+    const Map_view& view() const noexcept
+    {
+        return view_;
+    }
+
+private:
+    std::unique_ptr<impl::Mapped_file> mapping_;
+    Map_view view_;
+};
+
+namespace impl {
+
+template <>
+Property_view binary_element<Property_view>(
+    const Binary_sections&, const char*);
+template <>
+Frame binary_element<Frame>(const Binary_sections&, const char*);
+template <>
+Point binary_element<Point>(const Binary_sections&, const char*);
+template <>
+Object_view binary_element<Object_view>(const Binary_sections&, const char*);
+template <>
+Tile_view binary_element<Tile_view>(const Binary_sections&, const char*);
+template <>
+Image_collection_tile_view binary_element<Image_collection_tile_view>(
+    const Binary_sections&, const char*);
+template <>
+Map_view::Tile_set binary_element<Map_view::Tile_set>(
+    const Binary_sections&, const char*);
+template <>
+Map_view::Layer binary_element<Map_view::Layer>(
+    const Binary_sections&, const char*);
+
+} // namespace impl
+
+} // namespace tmxpp
+
+#endif // TMXPP_MAP_VIEW_HPP
@@ -1,6 +1,7 @@
 #ifndef TMXPP_OBJECT_HPP
 #define TMXPP_OBJECT_HPP
 
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <variant>
@@ -22,7 +23,7 @@ struct Object {
         pxSize size;
     };
     struct Polygon {
-        using Points = std::vector<Point>;
+        using Points = std::pmr::vector<Point>;
         Points points;
     };
     struct Polyline {
@@ -33,8 +34,8 @@ struct Object {
     using Shape = std::variant<Rectangle, Ellipse, Polygon, Polyline>;
 
     Unique_id unique_id;
-    std::string name;
-    std::string type;
+    std::pmr::string name;
+    std::pmr::string type;
     Point position;
     std::optional<Shape> shape;
     Degrees clockwise_rotation;
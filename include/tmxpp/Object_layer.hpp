@@ -1,6 +1,7 @@
 #ifndef TMXPP_OBJECT_LAYER_HPP
 #define TMXPP_OBJECT_LAYER_HPP
 
+#include <memory_resource>
 #include <optional>
 #include <vector>
 #include <tmxpp/Color.hpp>
@@ -12,7 +13,7 @@ namespace tmxpp {
 struct Object_layer : Layer {
     enum class Draw_order : unsigned char { top_down, index };
 
-    using Objects = std::vector<Object>;
+    using Objects = std::pmr::vector<Object>;
 
     std::optional<Color> color;
     Draw_order draw_order;
@@ -1,12 +1,13 @@
 #ifndef TMXPP_PROPERTIES_HPP
 #define TMXPP_PROPERTIES_HPP
 
+#include <memory_resource>
 #include <vector>
 #include <tmxpp/Property.hpp>
 
 namespace tmxpp {
 
-using Properties = std::vector<Property>;
+using Properties = std::pmr::vector<Property>;
 
 } // namespace tmxpp
 
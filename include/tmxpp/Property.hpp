@@ -1,6 +1,7 @@
 #ifndef TMXPP_PROPERTY_HPP
 #define TMXPP_PROPERTY_HPP
 
+#include <memory_resource>
 #include <string>
 #include <variant>
 #include <tmxpp/Color.hpp>
@@ -10,9 +11,10 @@
 namespace tmxpp {
 
 struct Property {
-    using Value = std::variant<std::string, int, double, bool, Color, File>;
+    using Value =
+        std::variant<std::pmr::string, int, double, bool, Color, File>;
 
-    Non_empty<std::string> name;
+    Non_empty<std::pmr::string> name;
     Value value;
 };
 
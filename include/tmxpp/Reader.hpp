@@ -0,0 +1,63 @@
+#ifndef TMXPP_READER_HPP
+#define TMXPP_READER_HPP
+
+#include <cstddef>
+#include <experimental/filesystem>
+#include <memory>
+#include <tmxpp/File.hpp>
+#include <tmxpp/Map.hpp>
+#include <tmxpp/Tile_id.hpp>
+#include <tmxpp/Tsx_cache.hpp>
+#include <tmxpp/read.hpp>
+
+namespace tmxpp {
+
+// A reader of many documents, which reuses the memory of the XML documents
+// and caches the TSXs between reads.
+// A `Reader` is not thread-safe.
+class Reader {
+public:
+    // Effects: Constructs a `Reader` which reads with `options`. Unless
+    //          `options.tsx_cache` is set, it uses its own cache of up to
+    //          `tsx_cache_capacity` TSXs.
+    explicit Reader(
+        Read_options options = {}, std::size_t tsx_cache_capacity = 64);
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    ~Reader();
+
+    // Returns: `tmxpp::read_tmx(tmx, options)`.
+    Map read_tmx(const std::experimental::filesystem::path& tmx);
+    // Returns: `tmxpp::read_tmx(tmx, resolve_tsx, options)`.
+    Map read_tmx(Document tmx, const Tsx_resolver& resolve_tsx = {});
+    // Returns: `tmxpp::read_tmx(tmx, resolve_tsx, options)`.
+    Map read_tmx(In_situ_document tmx, const Tsx_resolver& resolve_tsx = {});
+
+    // Effects: `tmxpp::read_tmx(tmx, callbacks, options)`.
+    void read_tmx(
+        const std::experimental::filesystem::path& tmx,
+        const Tmx_callbacks& callbacks);
+
+    // Returns: `tsx_cache().read_tsx(first_id, tsx, base)`.
+    Map::Tile_set read_tsx(
+        Global_tile_id first_id, File tsx,
+        const std::experimental::filesystem::path& base =
+            std::experimental::filesystem::current_path());
+
+    // Returns: The TSX cache in use.
+    Tsx_cache& tsx_cache() noexcept;
+
+    // Effects: Frees the memory kept for reuse.
+    void clear() noexcept;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tmxpp
+
+#endif // TMXPP_READER_HPP
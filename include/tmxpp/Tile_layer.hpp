@@ -12,13 +12,13 @@ struct Tile_layer : Layer {
     Data data;
 };
 
-inline bool operator==(const Tile_layer& l, const Tile_layer& r) noexcept
+inline bool operator==(const Tile_layer& l, const Tile_layer& r)
 {
     return static_cast<const Layer&>(l) == static_cast<const Layer&>(r) &&
            l.data == r.data;
 }
 
-inline bool operator!=(const Tile_layer& l, const Tile_layer& r) noexcept
+inline bool operator!=(const Tile_layer& l, const Tile_layer& r)
 {
     return !(l == r);
 }
@@ -1,6 +1,7 @@
 #ifndef TMXPP_TILE_SET_HPP
 #define TMXPP_TILE_SET_HPP
 
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -25,11 +26,11 @@ struct Tile_set {
         Animation animation;
     };
 
-    using Tiles = std::vector<Tile>;
+    using Tiles = std::pmr::vector<Tile>;
 
     Global_tile_id first_id;
     File tsx;
-    std::string name;
+    std::pmr::string name;
     pxSize tile_size;
     Non_negative<Pixels> spacing;
     Non_negative<Pixels> margin;
@@ -0,0 +1,419 @@
+#ifndef TMXPP_TMX_VIEW_HPP
+#define TMXPP_TMX_VIEW_HPP
+
+#include <cstddef>
+#include <experimental/filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <variant>
+#include <tmxpp/Color.hpp>
+#include <tmxpp/Data.hpp>
+#include <tmxpp/Degrees.hpp>
+#include <tmxpp/File.hpp>
+#include <tmxpp/Frame.hpp>
+#include <tmxpp/Map.hpp>
+#include <tmxpp/Object.hpp>
+#include <tmxpp/Object_layer.hpp>
+#include <tmxpp/Offset.hpp>
+#include <tmxpp/Point.hpp>
+#include <tmxpp/Size.hpp>
+#include <tmxpp/Tile_id.hpp>
+#include <tmxpp/Unique_id.hpp>
+#include <tmxpp/Unit_interval.hpp>
+#include <tmxpp/read.hpp>
+
+namespace rapidxml {
+
+template <class Ch>
+class xml_node;
+
+} // namespace rapidxml
+
+namespace tmxpp {
+
+namespace impl {
+
+class Xml;
+
+} // namespace impl
+
+// Read-only views of the elements of a parsed TMX or TSX, which read the
+// attributes of the elements on access.
+// Strings are views of the parsed document, and numbers are converted on
+// access. A view is valid as long as the `Loaded_document` it comes from is.
+// Accessors throw `Exception` if the attributes they read are invalid.
+namespace tmx {
+
+namespace impl {
+
+using Node = rapidxml::xml_node<char>;
+
+// Returns: The `T` of the element `node`.
+template <class T>
+T element(Node* node);
+
+// Returns: The next sibling of `node` which is an element of the same range of
+//          `T`s, or `nullptr` if there is none.
+template <class T>
+Node* next_element(Node* node) noexcept;
+
+struct View_access;
+
+} // namespace impl
+
+// A read-only range of the child elements viewed as `T`s, which are read on
+// access.
+template <class T>
+class Element_range {
+public:
+    using value_type = T;
+    using reference  = T;
+
+    // A multi-pass iterator, but only an input iterator, as it dereferences to
+    // a prvalue.
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = T;
+        using pointer           = void;
+
+        iterator() = default;
+
+        reference operator*() const
+        {
+            return impl::element<T>(node_);
+        }
+
+        iterator& operator++() noexcept
+        {
+            node_ = impl::next_element<T>(node_);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto i{*this};
+            ++*this;
+            return i;
+        }
+
+        friend bool operator==(iterator l, iterator r) noexcept
+        {
+            return l.node_ == r.node_;
+        }
+
+        friend bool operator!=(iterator l, iterator r) noexcept
+        {
+            return l.node_ != r.node_;
+        }
+
+    private:
+        explicit iterator(impl::Node* node) noexcept : node_{node}
+        {
+        }
+
+        impl::Node* node_{};
+
+        friend Element_range;
+    };
+
+    using const_iterator = iterator;
+
+    Element_range() = default;
+
+    iterator begin() const noexcept
+    {
+        return iterator{first_};
+    }
+
+    iterator end() const noexcept
+    {
+        return iterator{};
+    }
+
+    bool empty() const noexcept
+    {
+        return first_ == nullptr;
+    }
+
+private:
+    explicit Element_range(impl::Node* first) noexcept : first_{first}
+    {
+    }
+
+    impl::Node* first_{};
+
+    friend impl::View_access;
+};
+
+class Property_view {
+public:
+    using Value = std::variant<
+        std::string_view, int, double, bool, Color, File_view>;
+
+    std::string_view name() const;
+    Value value() const;
+
+private:
+    explicit Property_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+
+    friend impl::View_access;
+};
+
+using Properties_view = Element_range<Property_view>;
+
+class Image_view {
+public:
+    std::string_view source() const;
+    std::optional<Color> transparent() const;
+    std::optional<pxSize> size() const;
+
+private:
+    explicit Image_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+
+    friend impl::View_access;
+};
+
+class Object_view {
+public:
+    Unique_id unique_id() const;
+    std::string_view name() const;
+    std::string_view type() const;
+    Point position() const;
+    // Notes: The points of a polygon or polyline are converted on access.
+    std::optional<Object::Shape> shape() const;
+    Degrees clockwise_rotation() const;
+    std::optional<Global_tile_id> global_id() const;
+    bool visible() const;
+    Properties_view properties() const;
+
+private:
+    explicit Object_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+
+    friend impl::View_access;
+};
+
+class Layer_view {
+public:
+    std::string_view name() const;
+    Unit_interval opacity() const;
+    bool visible() const;
+    Offset offset() const;
+    Properties_view properties() const;
+
+protected:
+    explicit Layer_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+};
+
+class Tile_layer_view : public Layer_view {
+public:
+    iSize size() const;
+    Data::Format format() const;
+    // Returns: The encoded tile ids, as they are in the document.
+    std::string_view data() const;
+    // Returns: The decoded tile ids.
+    Data::Flipped_ids tile_ids() const;
+
+private:
+    using Layer_view::Layer_view;
+
+    friend impl::View_access;
+};
+
+class Object_layer_view : public Layer_view {
+public:
+    using Objects = Element_range<Object_view>;
+
+    std::optional<Color> color() const;
+    Object_layer::Draw_order draw_order() const;
+    Objects objects() const;
+
+private:
+    using Layer_view::Layer_view;
+
+    friend impl::View_access;
+};
+
+class Image_layer_view : public Layer_view {
+public:
+    std::optional<Image_view> image() const;
+
+private:
+    using Layer_view::Layer_view;
+
+    friend impl::View_access;
+};
+
+// A view of a `Tile_set::Tile` or `Image_collection::Tile`.
+class Tile_view {
+public:
+    Local_tile_id id() const;
+    Properties_view properties() const;
+    // Returns: The image of an `Image_collection::Tile`, and none otherwise.
+    std::optional<Image_view> image() const;
+    std::optional<Object_layer_view> collision_shape() const;
+    Element_range<Frame> animation() const;
+
+private:
+    explicit Tile_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+
+    friend impl::View_access;
+};
+
+// A view of a tile set of a TMX or of a TSX.
+// It is a `Tile_set` if it has an image, and an `Image_collection` otherwise.
+// Only `first_id` and `tsx` are available of an external tile set of a TMX, and
+// `first_id` is not available of a TSX.
+class Tile_set_view {
+public:
+    using Tiles = Element_range<Tile_view>;
+
+    Global_tile_id first_id() const;
+    // Returns: The TSX of an external tile set, and an empty view otherwise.
+    File_view tsx() const;
+    std::string_view name() const;
+    // Returns: The tile size, or the maximum tile size of an
+    //          `Image_collection`.
+    pxSize tile_size() const;
+    Non_negative<Pixels> spacing() const;
+    Non_negative<Pixels> margin() const;
+    Non_negative<int> tile_count() const;
+    Non_negative<int> columns() const;
+    Offset tile_offset() const;
+    Properties_view properties() const;
+    std::optional<Image_view> image() const;
+    Tiles tiles() const;
+
+private:
+    explicit Tile_set_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+
+    friend impl::View_access;
+};
+
+class Map_view {
+public:
+    using Tile_sets = Element_range<Tile_set_view>;
+
+    using Layer =
+        std::variant<Tile_layer_view, Object_layer_view, Image_layer_view>;
+    using Layers = Element_range<Layer>;
+
+    std::string_view version() const;
+    Map::Orientation orientation() const;
+    Map::Render_order render_order() const;
+    iSize size() const;
+    pxSize general_tile_size() const;
+    std::optional<Color> background() const;
+    Unique_id next_id() const;
+    Properties_view properties() const;
+    Tile_sets tile_sets() const;
+    Layers layers() const;
+
+private:
+    explicit Map_view(impl::Node* node) noexcept : node_{node}
+    {
+    }
+
+    impl::Node* node_;
+
+    friend impl::View_access;
+};
+
+// A parsed TMX or TSX, whose elements are viewed without being read into the
+// TMX-format abstracting types.
+class Loaded_document {
+public:
+    // Effects: Loads and parses the document `path`, in place from a private
+    //          memory mapping if possible.
+    // Throws: `Exception` in case of loading or parsing error.
+    explicit Loaded_document(const std::experimental::filesystem::path& path);
+
+    // Effects: Parses a copy of `document`.
+    // Throws: `Exception` in case of parsing error.
+    explicit Loaded_document(Document document);
+
+    // Effects: Parses `document` in place, leaving its contents unspecified.
+    //          `document` shall outlive `*this`.
+    // Throws: `Exception` in case of parsing error.
+    explicit Loaded_document(In_situ_document document);
+
+    Loaded_document(Loaded_document&&) noexcept;
+    Loaded_document& operator=(Loaded_document&&) noexcept;
+
+    ~Loaded_document();
+
+    // Returns: A view of the map of a TMX.
+    // Throws: `Exception` if the document is not a TMX.
+    Map_view map() const;
+
+    // Returns: A view of the tile set of a TSX.
+    // Throws: `Exception` if the document is not a TSX.
+    Tile_set_view tile_set() const;
+
+private:
+    std::unique_ptr<tmxpp::impl::Xml> xml_;
+};
+
+namespace impl {
+
+template <>
+Property_view element<Property_view>(Node*);
+template <>
+Frame element<Frame>(Node*);
+template <>
+Object_view element<Object_view>(Node*);
+template <>
+Tile_view element<Tile_view>(Node*);
+template <>
+Tile_set_view element<Tile_set_view>(Node*);
+template <>
+Map_view::Layer element<Map_view::Layer>(Node*);
+
+template <>
+Node* next_element<Property_view>(Node*) noexcept;
+template <>
+Node* next_element<Frame>(Node*) noexcept;
+template <>
+Node* next_element<Object_view>(Node*) noexcept;
+template <>
+Node* next_element<Tile_view>(Node*) noexcept;
+template <>
+Node* next_element<Tile_set_view>(Node*) noexcept;
+template <>
+Node* next_element<Map_view::Layer>(Node*) noexcept;
+
+} // namespace impl
+
+} // namespace tmx
+
+} // namespace tmxpp
+
+#endif // TMXPP_TMX_VIEW_HPP
@@ -0,0 +1,68 @@
+#ifndef TMXPP_TSX_CACHE_HPP
+#define TMXPP_TSX_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <experimental/filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <tmxpp/File.hpp>
+#include <tmxpp/Map.hpp>
+#include <tmxpp/Tile_id.hpp>
+#include <tmxpp/read.hpp>
+
+namespace tmxpp {
+
+// A thread-safe, least recently used cache of read TSXs.
+class Tsx_cache {
+public:
+    // Effects: Constructs an empty cache of up to `capacity` TSXs.
+    explicit Tsx_cache(std::size_t capacity = 64);
+
+    Tsx_cache(const Tsx_cache&) = delete;
+    Tsx_cache& operator=(const Tsx_cache&) = delete;
+
+    // Returns: `read_tsx(first_id, tsx, base)`.
+    // Effects: Reads the TSX unless it is cached and its file's last write time
+    //          and size are unchanged, and caches it.
+    Map::Tile_set read_tsx(
+        Global_tile_id first_id, File tsx,
+        const std::experimental::filesystem::path& base =
+            std::experimental::filesystem::current_path());
+
+    // Returns: A `Tsx_resolver` which calls `read_tsx(first_id, tsx, base)`.
+    Tsx_resolver resolver(const std::experimental::filesystem::path& base);
+
+    // Effects: Removes the TSX `absolute(tsx, base)` from the cache.
+    void invalidate(
+        const File& tsx, const std::experimental::filesystem::path& base =
+                             std::experimental::filesystem::current_path());
+
+    // Effects: Removes all TSXs from the cache.
+    void clear() noexcept;
+
+    std::size_t size() const;
+    std::size_t capacity() const noexcept;
+
+private:
+    struct Entry {
+        std::string path;
+        std::experimental::filesystem::file_time_type last_write_time;
+        std::uintmax_t file_size;
+        std::shared_ptr<const Map::Tile_set> tile_set;
+    };
+
+    using Entries = std::list<Entry>;
+
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    Entries entries_; // Most recently used first.
+    std::unordered_map<std::string, Entries::iterator> index_;
+};
+
+} // namespace tmxpp
+
+#endif // TMXPP_TSX_CACHE_HPP
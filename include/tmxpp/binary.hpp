@@ -0,0 +1,22 @@
+#ifndef TMXPP_BINARY_HPP
+#define TMXPP_BINARY_HPP
+
+#include <experimental/filesystem>
+#include <string>
+#include <tmxpp/Map.hpp>
+#include <tmxpp/read.hpp>
+#include <tmxpp/write.hpp>
+
+namespace tmxpp {
+
+void write_binary(const Map&, const std::experimental::filesystem::path&);
+void write_binary(const Map&, const Sink&);
+std::string to_binary(const Map&);
+
+Map read_binary(
+    const std::experimental::filesystem::path&, const Read_options& = {});
+Map read_binary(Document, const Read_options& = {});
+
+} // namespace tmxpp
+
+#endif // TMXPP_BINARY_HPP
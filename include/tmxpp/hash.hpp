@@ -0,0 +1,30 @@
+#ifndef TMXPP_HASH_HPP
+#define TMXPP_HASH_HPP
+
+#include <cstdint>
+#include <tmxpp/Image_collection.hpp>
+#include <tmxpp/Image_layer.hpp>
+#include <tmxpp/Map.hpp>
+#include <tmxpp/Object_layer.hpp>
+#include <tmxpp/Properties.hpp>
+#include <tmxpp/Tile_layer.hpp>
+#include <tmxpp/Tile_set.hpp>
+
+namespace tmxpp {
+
+std::uint_least64_t hash(const Properties&);
+
+std::uint_least64_t hash(const Tile_layer&);
+std::uint_least64_t hash(const Object_layer&);
+std::uint_least64_t hash(const Image_layer&);
+std::uint_least64_t hash(const Map::Layer&);
+
+std::uint_least64_t hash(const Tile_set&);
+std::uint_least64_t hash(const Image_collection&);
+std::uint_least64_t hash(const Map::Tile_set&);
+
+std::uint_least64_t hash(const Map&);
+
+} // namespace tmxpp
+
+#endif // TMXPP_HASH_HPP
@@ -0,0 +1,67 @@
+#ifndef TMXPP_IMPL_BLOCK_RECYCLER_HPP
+#define TMXPP_IMPL_BLOCK_RECYCLER_HPP
+
+#include <cstddef>
+
+namespace tmxpp::impl {
+
+// Keeps the memory blocks of rapidxml documents for reuse by later documents.
+// `allocate` and `deallocate` are suitable for `xml_document::set_allocator`.
+class Block_recycler {
+public:
+    // Makes `allocate` use a `Block_recycler` on the calling thread for the
+    // lifetime of the `Use`.
+    class Use {
+    public:
+        explicit Use(Block_recycler& recycler) noexcept : previous_{current}
+        {
+            current = &recycler;
+        }
+
+        Use(const Use&) = delete;
+        Use& operator=(const Use&) = delete;
+
+        ~Use()
+        {
+            current = previous_;
+        }
+
+    private:
+        Block_recycler* previous_;
+    };
+
+    Block_recycler() = default;
+
+    Block_recycler(const Block_recycler&) = delete;
+    Block_recycler& operator=(const Block_recycler&) = delete;
+
+    // Requires: The blocks allocated with `*this` in use are deallocated.
+    ~Block_recycler();
+
+    // Effects: Frees the kept blocks.
+    void release() noexcept;
+
+    // Returns: A block of at least `size` bytes. It is a kept block of the
+    //          `Block_recycler` in use on the calling thread, if it has one
+    //          large enough.
+    static void* allocate(std::size_t size);
+
+    // Effects: Keeps the block `p` in the `Block_recycler` in use when it was
+    //          allocated, if any, and frees it otherwise.
+    static void deallocate(void* p) noexcept;
+
+private:
+    struct alignas(std::max_align_t) Header {
+        std::size_t size;
+        Block_recycler* owner;
+        Header* next;
+    };
+
+    Header* kept_{};
+
+    static thread_local Block_recycler* current;
+};
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_BLOCK_RECYCLER_HPP
@@ -0,0 +1,50 @@
+#ifndef TMXPP_IMPL_MAPPED_FILE_HPP
+#define TMXPP_IMPL_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <gsl/gsl>
+#include <gsl/string_span>
+
+namespace tmxpp::impl {
+
+// A private, copy-on-write memory mapping of a file followed by a null
+// character, suitable for in-situ parsing without copying the file.
+class Mapped_file {
+public:
+    // The expected access pattern of the mapping.
+    enum class Access { sequential, random };
+
+    // Effects: Maps the file `path` and advises `access`.
+    // Throws: `Exception` if the file could not be mapped, for example if it
+    //         is empty or not a regular file.
+    explicit Mapped_file(
+        gsl::not_null<gsl::czstring<>> path,
+        Access access = Access::sequential);
+
+    Mapped_file(const Mapped_file&) = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    ~Mapped_file();
+
+    // Returns: The contents of the file, followed by a null character.
+    // Notes: Writes do not reach the file.
+    char* data() const noexcept
+    {
+        return static_cast<char*>(address_);
+    }
+
+    // Returns: The size of the file.
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    void* address_;
+    std::size_t mapping_size_;
+    std::size_t size_;
+};
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_MAPPED_FILE_HPP
@@ -0,0 +1,47 @@
+#ifndef TMXPP_IMPL_MODEL_RESOURCE_HPP
+#define TMXPP_IMPL_MODEL_RESOURCE_HPP
+
+#include <memory_resource>
+
+namespace tmxpp::impl {
+
+// The memory resource which the model read on the calling thread allocates
+// from.
+class Model_resource {
+public:
+    // Makes `get` return a memory resource on the calling thread for the
+    // lifetime of the `Use`. A null pointer stands for the default resource.
+    class Use {
+    public:
+        explicit Use(std::pmr::memory_resource* resource) noexcept
+          : previous_{current}
+        {
+            current = resource;
+        }
+
+        Use(const Use&) = delete;
+        Use& operator=(const Use&) = delete;
+
+        ~Use()
+        {
+            current = previous_;
+        }
+
+    private:
+        std::pmr::memory_resource* previous_;
+    };
+
+    // Returns: The memory resource in use on the calling thread, or the
+    //          default memory resource if there is none.
+    static std::pmr::memory_resource* get() noexcept
+    {
+        return current ? current : std::pmr::get_default_resource();
+    }
+
+private:
+    inline static thread_local std::pmr::memory_resource* current{};
+};
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_MODEL_RESOURCE_HPP
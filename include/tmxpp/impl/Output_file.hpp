@@ -0,0 +1,56 @@
+#ifndef TMXPP_IMPL_OUTPUT_FILE_HPP
+#define TMXPP_IMPL_OUTPUT_FILE_HPP
+
+#include <cstdio>
+#include <experimental/filesystem>
+#include <tmxpp/write.hpp>
+
+namespace tmxpp::impl {
+
+// A file written through a uniquely named sibling temporary file, which
+// replaces it only on `commit()`, so that an error while writing leaves any
+// existing file as it was.
+class Output_file {
+public:
+    // Effects: Creates a temporary file for writing the file `path`.
+    // Throws: `Exception` if it could not be created.
+    explicit Output_file(std::experimental::filesystem::path path);
+
+    Output_file(const Output_file&) = delete;
+    Output_file& operator=(const Output_file&) = delete;
+
+    // Effects: Closes and removes the temporary file, unless it was committed.
+    ~Output_file();
+
+    // Returns: A `Sink` which writes to the temporary file, and throws
+    //          `Exception` if it could not. `*this` shall outlive it.
+    Sink sink();
+
+    // Effects: Flushes and closes the temporary file.
+    // Throws: `Exception` if it could not be written.
+    void close();
+
+    // Requires: `close()` succeeded.
+    // Effects: Replaces the file with the temporary file.
+    // Throws: `Exception` if it could not.
+    void commit();
+
+    // Effects: Equivalent to `close(); commit();`.
+    void finish()
+    {
+        close();
+        commit();
+    }
+
+private:
+    [[noreturn]] void throw_write_error() const;
+
+    std::experimental::filesystem::path path_;
+    std::experimental::filesystem::path temporary_;
+    std::FILE* file_{};
+    bool committed_{};
+};
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_OUTPUT_FILE_HPP
@@ -4,10 +4,10 @@
 #include <exception>
 #include <new>
 #include <optional>
-#include <ostream>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 #include <gsl/gsl>
 #include <gsl/string_span>
 #include <range/v3/view/filter.hpp>
@@ -16,10 +16,11 @@
 #include <range/v3/view/transform.hpp>
 #include <rapidxml.hpp>
 #include <rapidxml_iterators.hpp>
-#include <rapidxml_print.hpp>
 #include <rapidxml_utils.hpp>
 #include <tmxpp/Strong_typedef.hpp>
 #include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Block_recycler.hpp>
+#include <tmxpp/impl/Mapped_file.hpp>
 
 namespace tmxpp::impl {
 
@@ -62,24 +63,26 @@ public:
         using Name  = Strong_typedef<std::string_view, struct _element_name>;
         using Value = Strong_typedef<std::string_view, struct _element_value>;
 
-        Name name() const noexcept
+        using underlying_type = rapidxml::xml_node<>;
+
+        // Requires: `u` is an element of a parsed document.
+        explicit Element(underlying_type* u) noexcept : elem{u}
         {
-            return Name{elem->name_ref()};
         }
 
-        Value value() const noexcept
+        underlying_type* underlying() const noexcept
         {
-            return Value{elem->value_ref()};
+            return elem;
         }
 
-        void value(Value value) const noexcept
+        Name name() const noexcept
         {
-            elem->value(get(value));
+            return Name{elem->name_ref()};
         }
 
-        void value(std::string&& value) const
+        Value value() const noexcept
         {
-            this->value(Value{elem->document()->allocate_string(value)});
+            return Value{elem->value_ref()};
         }
 
         // Returns: An `Attribute` with the given `name`.
@@ -107,6 +110,22 @@ public:
             return {};
         }
 
+        // Returns: The next sibling `Element`, if any.
+        std::optional<Element> next_sibling() const noexcept
+        {
+            if (auto sibling{elem->next_sibling()})
+                return Element{sibling};
+            return {};
+        }
+
+        // Returns: The next sibling `Element` with the given `name`, if any.
+        std::optional<Element> next_sibling(Name name) const noexcept
+        {
+            if (auto sibling{elem->next_sibling(get(name))})
+                return Element{sibling};
+            return {};
+        }
+
         // Returns: A `ranges::InputView` of the `Attribute`s filtered by
         //          `name`.
         auto attributes(Attribute::Name name) const noexcept
@@ -148,77 +167,76 @@ public:
                        [](auto&& child) { return Element{&child}; });
         }
 
-        // Effects: Adds an `Attribute` with the given `name` and `value`.
-        void add(Attribute::Name name, Attribute::Value value) const
-        {
-            auto doc{elem->document()};
-
-            if (!get(value).empty())
-                value = Attribute::Value{doc->allocate_string(get(value))};
-
-            elem->append_attribute(
-                doc->allocate_attribute(get(name), get(value)));
-        }
-
-        // Effects: Adds a child `Element` with the given `name`.
-        // Returns: The added `Element`.
-        Element add(Name name) const
-        {
-            elem->append_node(elem->document()->allocate_node(
-                rapidxml::node_element, get(name)));
-
-            return Element{elem->last_node()};
-        }
-
     private:
-        using underlying_type = rapidxml::xml_node<>;
-
-        explicit Element(underlying_type* u) noexcept : elem{u}
-        {
-        }
-
         underlying_type* elem;
-
-        friend Xml;
     };
 
-    // Effects: Loads and parses the `Xml` `path`.
-    // Throws: `Exception` in case of loading or parsing error or lack of root
-    //         element.
-    explicit Xml(gsl::not_null<gsl::czstring<>> path) try : xml(path) {
-        doc.parse<rapidxml::parse_fastest>(std::as_const(xml)->data());
+    // A document to parse from a copy.
+    using Text = Strong_typedef<std::string_view, struct _text>;
+    // A null-terminated document to parse in place.
+    using In_situ_text = Strong_typedef<char*, struct _in_situ_text>;
 
-        if (root().elem == nullptr)
-            throw Exception{std::string{path} + " has no root element."};
+    // Effects: Creates an `Xml` without document, whose memory is allocated
+    //          by `Block_recycler`.
+    Xml()
+    {
+        doc.set_allocator(Block_recycler::allocate, Block_recycler::deallocate);
     }
-    catch (const std::bad_alloc&) {
-        throw;
+
+    // Effects: Equivalent to `Xml xml; xml.load(path);`.
+    explicit Xml(gsl::not_null<gsl::czstring<>> path) : Xml()
+    {
+        load(path);
     }
-    catch (const std::exception& e) {
-        throw Exception{e.what()};
+
+    // Effects: Equivalent to `Xml xml; xml.load(text);`.
+    explicit Xml(Text text) : Xml()
+    {
+        load(text);
     }
 
-    // Effects: Creates an `Xml` with the root `Element` `name`.
-    explicit Xml(Element::Name name)
+    // Effects: Equivalent to `Xml xml; xml.load(text);`.
+    explicit Xml(In_situ_text text) : Xml()
     {
-        doc.append_node(doc.allocate_node(rapidxml::node_element, get(name)));
+        load(text);
     }
 
     Xml(const Xml&) = delete;
     Xml& operator=(const Xml&) = delete;
 
+    // Effects: Replaces the document with the loaded and parsed `Xml` `path`.
+    //          The file is parsed in place from a private memory mapping if
+    //          possible, and from a copy otherwise.
+    // Throws: `Exception` in case of loading or parsing error or lack of root
+    //         element.
+    void load(gsl::not_null<gsl::czstring<>> path);
+
+    // Effects: Replaces the document with a parsed copy of `text`.
+    // Throws: `Exception` in case of parsing error or lack of root element.
+    void load(Text text);
+
+    // Effects: Replaces the document with `text` parsed in place, leaving its
+    //          contents unspecified.
+    // Throws: `Exception` in case of parsing error or lack of root element.
+    void load(In_situ_text text);
+
+    // Effects: Discards the document, keeping the memory of the copy of a
+    //          `Text` for reuse.
+    void clear() noexcept;
+
     Element root() const noexcept
     {
         return Element{doc.first_node()};
     }
 
-    friend std::ostream& operator<<(std::ostream& os, const Xml& xml)
-    {
-        return os << xml.doc;
-    }
-
 private:
+    // Returns: The contents of the mapped file `path`, or `nullptr` if it
+    //          could not be mapped.
+    char* map(gsl::not_null<gsl::czstring<>> path) noexcept;
+
+    std::optional<Mapped_file> mapping;
     std::optional<rapidxml::file<>> xml;
+    std::vector<char> copy;
     rapidxml::xml_document<> doc;
 };
 
@@ -0,0 +1,110 @@
+#ifndef TMXPP_IMPL_XML_WRITER_HPP
+#define TMXPP_IMPL_XML_WRITER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tmxpp/impl/Xml.hpp>
+
+namespace tmxpp::impl {
+
+// Writes an xml document to a sink as it is described, without building it in
+// memory first.
+// Elements are described depth-first: an `Element`'s attributes precede its
+// children or value, and its children are described one after the other.
+class Xml_writer {
+public:
+    class Element {
+    public:
+        using Name = Xml::Element::Name;
+        using Value = Xml::Element::Value;
+
+        // Requires: No child or value was added to `*this`.
+        // Effects: Adds an `Attribute` with the given `name` and `value`.
+        void add(Xml::Attribute::Name name, Xml::Attribute::Value value) const
+        {
+            writer->attribute(name, value);
+        }
+
+        // Requires: No value was added to `*this`.
+        // Effects: Ends the children added to `*this` and adds a child
+        //          `Element` with the given `name`.
+        // Returns: The added `Element`.
+        Element add(Name name) const
+        {
+            writer->start(depth, name);
+            return Element{writer, depth + 1};
+        }
+
+        // Requires: No child or value was added to `*this`.
+        // Effects: Adds `value` as the content of `*this`.
+        void value(Value value) const
+        {
+            writer->value(get(value));
+        }
+
+    private:
+        Element(Xml_writer* w, std::size_t d) noexcept : writer{w}, depth{d}
+        {
+        }
+
+        Xml_writer* writer;
+        std::size_t depth;
+
+        friend Xml_writer;
+    };
+
+    // Consumes the next chunk of the document.
+    using Sink = std::function<void(std::string_view)>;
+
+    // Effects: Starts writing to `sink` a document with the root `Element`
+    //          `name`.
+    Xml_writer(Sink sink, Element::Name name);
+
+    Xml_writer(const Xml_writer&) = delete;
+    Xml_writer& operator=(const Xml_writer&) = delete;
+
+    Element root() noexcept
+    {
+        return Element{this, 1};
+    }
+
+    // Effects: Ends the open elements and flushes the written document to the
+    //          sink.
+    void finish();
+
+private:
+    void start(std::size_t depth, Element::Name name);
+    void attribute(Xml::Attribute::Name name, Xml::Attribute::Value value);
+    void value(std::string_view value);
+
+    // Effects: Ends the open elements deeper than `depth`.
+    void end(std::size_t depth);
+
+    // Effects: Ends the start tag of the innermost open element, if open.
+    void close_start_tag();
+
+    void put(std::string_view s);
+    void put(char c);
+    // Effects: Puts `s` with the characters in `special` replaced by
+    //          references.
+    void put_escaped(std::string_view s, std::string_view special);
+    void flush();
+
+    struct Open_element {
+        std::string_view name;
+        bool has_children;
+        bool has_value;
+    };
+
+    Sink sink_;
+    std::string buffer_;
+    std::vector<Open_element> open_;
+    bool start_tag_open_{};
+};
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_XML_WRITER_HPP
@@ -0,0 +1,55 @@
+#ifndef TMXPP_IMPL_BASE64_HPP
+#define TMXPP_IMPL_BASE64_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace tmxpp::impl::base64 {
+
+// Returns: The maximum number of bytes that `encoded_size` base64 characters
+//          decode to.
+constexpr std::size_t decoded_size_bound(std::size_t encoded_size) noexcept
+{
+    return encoded_size / 4 * 3 + 3;
+}
+
+// Returns: The number of base64 characters that `size` bytes encode to.
+constexpr std::size_t encoded_size(std::size_t size) noexcept
+{
+    return (size + 2) / 3 * 4;
+}
+
+// Incremental decoder of the standard base64 alphabet with padding.
+// Whitespace anywhere in the input is skipped.
+class Decoder {
+public:
+    // Requires: `out` has room for `decoded_size_bound(in.size())` bytes.
+    // Effects: Decodes the next part of the input into `out`.
+    // Returns: The number of bytes written to `out`, or no value if `in` is
+    //          not a valid continuation of the input.
+    std::optional<std::size_t> decode(
+        std::string_view in, unsigned char* out) noexcept;
+
+    // Returns: `true` if the input so far ends at the end of a base64
+    //          quantum, and `false` otherwise.
+    bool finished() const noexcept
+    {
+        return pending_ == 0 && padding_ == 0;
+    }
+
+private:
+    std::uint_least32_t bits_{};
+    int pending_{};
+    int padding_{};
+    bool done_{};
+};
+
+// Returns: `in` base64-encoded.
+std::string encode(const unsigned char* in, std::size_t size);
+
+} // namespace tmxpp::impl::base64
+
+#endif // TMXPP_IMPL_BASE64_HPP
@@ -0,0 +1,377 @@
+#ifndef TMXPP_IMPL_BINARY_FORMAT_HPP
+#define TMXPP_IMPL_BINARY_FORMAT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <tmxpp/Map_view.hpp>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/little_endian.hpp>
+
+// The layout of a binary TMX, in which a `Map` is stored as fixed-size records
+// which refer to each other by offset, so that it can be read in place.
+//
+// A binary TMX begins with a header of
+//     char magic[4], u32 version, u32 section_count, u32 reserved
+// followed by `section_count` sections, each with a header of
+//     char tag[4], u32 reserved, u64 size
+// followed by `size` bytes of payload padded with zeros to a multiple of
+// `alignment`. Readers skip sections with unknown tags.
+// Numbers are little endian, and doubles are IEEE 754 binary64.
+//
+// The sections are
+// - `strings_tag`: The characters of the strings.
+// - `records_tag`: The records, beginning with the `map` record.
+// - `tile_ids_tag`: The raw tile ids of the tile layers, as `u32`s.
+//
+// The fields of the records are numbers and references of `reference_size`:
+// - A string is a `u32` offset into the strings and a `u32` size.
+// - An array is a `u32` offset into the records and a `u32` count of
+//   contiguous records of the element's size.
+// - Tile ids are a `u32` index into the tile ids and a `u32` count.
+// Colors are four `u8`s in the order a, r, g, b. `flags` are `u8`s of bits.
+namespace tmxpp::impl::binary {
+
+constexpr char magic[4]{'T', 'M', 'X', 'B'};
+constexpr std::uint_least32_t version{1};
+
+constexpr std::size_t header_size{16};
+constexpr std::size_t section_header_size{16};
+constexpr std::size_t alignment{8};
+
+constexpr char strings_tag[4]{'S', 'T', 'R', 'S'};
+constexpr char records_tag[4]{'R', 'E', 'C', 'S'};
+constexpr char tile_ids_tag[4]{'T', 'I', 'D', 'S'};
+
+constexpr std::size_t reference_size{8};
+
+namespace property {
+constexpr std::size_t name{0};
+// The `Property::Value` alternative, of which a `bool` is a `u8`, and an
+// `int` an `i32`.
+constexpr std::size_t value{8};
+// The index of the `Property::Value` alternative, as a `u8`.
+constexpr std::size_t kind{16};
+constexpr std::size_t size{24};
+} // namespace property
+
+namespace image {
+constexpr std::size_t source{0};
+constexpr std::size_t width{8};
+constexpr std::size_t height{16};
+constexpr std::size_t transparent{24};
+constexpr std::size_t flags{28};
+constexpr std::size_t size{32};
+
+constexpr std::uint_least8_t has_transparent{1 << 0};
+constexpr std::uint_least8_t has_size{1 << 1};
+} // namespace image
+
+namespace frame {
+constexpr std::size_t id{0};
+constexpr std::size_t duration{4};
+constexpr std::size_t size{8};
+} // namespace frame
+
+namespace point {
+constexpr std::size_t x{0};
+constexpr std::size_t y{8};
+constexpr std::size_t size{16};
+} // namespace point
+
+namespace object {
+constexpr std::size_t name{0};
+constexpr std::size_t type{8};
+constexpr std::size_t x{16};
+constexpr std::size_t y{24};
+constexpr std::size_t clockwise_rotation{32};
+// An array of `point`s, of a polygon or polyline.
+constexpr std::size_t points{40};
+// The size of a rectangle or ellipse.
+constexpr std::size_t width{48};
+constexpr std::size_t height{56};
+constexpr std::size_t properties{64};
+constexpr std::size_t unique_id{72};
+// `0` if the `Object` has no global id.
+constexpr std::size_t global_id{76};
+// `0` if the `Object` has no shape, and one past the index of the
+// `Object::Shape` alternative otherwise.
+constexpr std::size_t shape{80};
+constexpr std::size_t visible{81};
+constexpr std::size_t size{88};
+} // namespace object
+
+// A record of each alternative of `Map::Layer`, which share the fields of
+// `Layer`.
+namespace layer {
+constexpr std::size_t name{0};
+constexpr std::size_t opacity{8};
+constexpr std::size_t offset_x{16};
+constexpr std::size_t offset_y{24};
+constexpr std::size_t properties{32};
+// The index of the `Map::Layer` alternative.
+constexpr std::size_t kind{40};
+constexpr std::size_t visible{41};
+
+// `Tile_layer`.
+constexpr std::size_t width{48};
+constexpr std::size_t height{52};
+constexpr std::size_t tile_ids{56};
+constexpr std::size_t encoding{64};
+constexpr std::size_t compression{65};
+
+// `Object_layer`.
+constexpr std::size_t objects{48};
+constexpr std::size_t color{56};
+constexpr std::size_t object_flags{60};
+constexpr std::size_t draw_order{61};
+
+constexpr std::uint_least8_t has_color{1 << 0};
+
+// `Image_layer`.
+constexpr std::size_t image{48};
+constexpr std::size_t image_flags{48 + image::size};
+
+constexpr std::uint_least8_t has_image{1 << 0};
+
+constexpr std::size_t size{88};
+} // namespace layer
+
+// A record of `Tile_set::Tile` and `Image_collection::Tile`.
+namespace tile {
+constexpr std::size_t id{0};
+constexpr std::size_t properties{8};
+// An array of `frame`s.
+constexpr std::size_t animation{16};
+// An array of none or one object `layer`.
+constexpr std::size_t collision_shape{24};
+// `Image_collection::Tile` only.
+constexpr std::size_t image{32};
+constexpr std::size_t size{64};
+} // namespace tile
+
+// A record of each alternative of `Map::Tile_set`.
+namespace tile_set {
+constexpr std::size_t tsx{0};
+constexpr std::size_t name{8};
+// The tile size, or the maximum tile size of an `Image_collection`.
+constexpr std::size_t tile_width{16};
+constexpr std::size_t tile_height{24};
+constexpr std::size_t spacing{32};
+constexpr std::size_t margin{40};
+constexpr std::size_t tile_offset_x{48};
+constexpr std::size_t tile_offset_y{56};
+constexpr std::size_t properties{64};
+constexpr std::size_t tiles{72};
+// `Tile_set` only.
+constexpr std::size_t image{80};
+constexpr std::size_t first_id{112};
+constexpr std::size_t columns{116};
+// `Tile_set` only.
+constexpr std::size_t rows{120};
+// `Image_collection` only.
+constexpr std::size_t tile_count{124};
+// The index of the `Map::Tile_set` alternative.
+constexpr std::size_t kind{128};
+constexpr std::size_t size{136};
+} // namespace tile_set
+
+namespace map {
+constexpr std::size_t version{0};
+constexpr std::size_t tile_width{8};
+constexpr std::size_t tile_height{16};
+// `Map::Hexagonal` only.
+constexpr std::size_t side_length{24};
+constexpr std::size_t properties{32};
+constexpr std::size_t tile_sets{40};
+constexpr std::size_t layers{48};
+constexpr std::size_t width{56};
+constexpr std::size_t height{60};
+constexpr std::size_t next_id{64};
+constexpr std::size_t background{68};
+// The index of the `Map::Orientation` alternative.
+constexpr std::size_t orientation{72};
+// `Map::Staggered` and `Map::Hexagonal` only.
+constexpr std::size_t stagger_axis{73};
+constexpr std::size_t stagger_index{74};
+constexpr std::size_t render_order{75};
+constexpr std::size_t flags{76};
+constexpr std::size_t size{80};
+
+constexpr std::uint_least8_t has_background{1 << 0};
+} // namespace map
+
+template <class T>
+constexpr bool is_field_v{
+    std::is_same_v<T, std::uint_least8_t> ||
+    std::is_same_v<T, std::uint_least32_t> ||
+    std::is_same_v<T, std::int_least32_t> ||
+    std::is_same_v<T, std::uint_least64_t> || std::is_same_v<T, double>};
+
+static_assert(sizeof(std::uint_least32_t) == 4);
+static_assert(sizeof(std::int_least32_t) == 4);
+static_assert(sizeof(std::uint_least64_t) == 8);
+static_assert(sizeof(double) == 8);
+
+// Returns: The field stored at `p`.
+template <class T, class = std::enable_if_t<is_field_v<T>>>
+T load(const char* p) noexcept
+{
+    using Bits = std::conditional_t<
+        sizeof(T) == 1, std::uint_least8_t,
+        std::conditional_t<
+            sizeof(T) == 4, std::uint_least32_t, std::uint_least64_t>>;
+
+    Bits bits;
+    std::memcpy(&bits, p, sizeof(bits));
+    if constexpr (sizeof(T) != 1)
+        bits = little_endian(bits);
+
+    T x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// Effects: Stores the field `x` at `p`.
+template <class T, class = std::enable_if_t<is_field_v<T>>>
+void store(char* p, T x) noexcept
+{
+    using Bits = std::conditional_t<
+        sizeof(T) == 1, std::uint_least8_t,
+        std::conditional_t<
+            sizeof(T) == 4, std::uint_least32_t, std::uint_least64_t>>;
+
+    Bits bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    if constexpr (sizeof(T) != 1)
+        bits = little_endian(bits);
+
+    std::memcpy(p, &bits, sizeof(bits));
+}
+
+// Throws: `Exception` describing a binary TMX as invalid because of `what`.
+[[noreturn]] inline void throw_invalid(const char* what)
+{
+    throw Exception{std::string{"Invalid binary TMX: "} + what + '.'};
+}
+
+// Returns: `value` as an `Enum` whose last enumerator is `last`.
+// Throws: `Exception` if `value` is greater than `last`.
+template <class Enum>
+Enum to_enum(std::uint_least8_t value, Enum last)
+{
+    if (value > static_cast<std::uint_least8_t>(last))
+        throw_invalid("enumerator out of range");
+
+    return static_cast<Enum>(value);
+}
+
+// Returns: The sections of the binary TMX `binary`.
+// Throws: `Exception` if `binary` is not a binary TMX of the supported
+//         version.
+inline Binary_sections find_sections(std::string_view binary)
+{
+    if (binary.size() < header_size ||
+        binary.compare(0, sizeof(magic), magic, sizeof(magic)) != 0)
+        throw Exception{"Not a binary TMX."};
+
+    if (auto v{load<std::uint_least32_t>(binary.data() + 4)}; v != version)
+        throw Exception{
+            "Unsupported binary TMX version " + std::to_string(v) + '.'};
+
+    auto count{load<std::uint_least32_t>(binary.data() + 8)};
+    binary.remove_prefix(header_size);
+
+    Binary_sections sections;
+
+    for (; count != 0; --count) {
+        if (binary.size() < section_header_size)
+            throw_invalid("truncated section header");
+
+        const auto tag{binary.substr(0, 4)};
+        const auto size{load<std::uint_least64_t>(binary.data() + 8)};
+        binary.remove_prefix(section_header_size);
+
+        if (size > binary.size())
+            throw_invalid("truncated section");
+
+        const auto payload{binary.substr(0, size)};
+        const auto padded_size{(size + alignment - 1) / alignment * alignment};
+        binary.remove_prefix(
+            std::min<std::uint_least64_t>(padded_size, binary.size()));
+
+        if (tag == std::string_view{strings_tag, sizeof(strings_tag)})
+            sections.strings = payload;
+        else if (tag == std::string_view{records_tag, sizeof(records_tag)})
+            sections.records = payload;
+        else if (tag == std::string_view{tile_ids_tag, sizeof(tile_ids_tag)})
+            sections.tile_ids = payload;
+    }
+
+    if (sections.tile_ids.size() % sizeof(std::uint_least32_t) != 0)
+        throw_invalid("partial tile id");
+
+    return sections;
+}
+
+// Returns: The first of `count` records of `size` bytes at `offset` of
+//          `records`.
+// Throws: `Exception` if they are out of bounds.
+inline const char* load_records(
+    std::string_view records, std::uint_least32_t offset, std::size_t count,
+    std::size_t size)
+{
+    if (offset > records.size() || count > (records.size() - offset) / size)
+        throw_invalid("record out of bounds");
+
+    return records.data() + offset;
+}
+
+// Returns: The string of `strings` referred to at `p`.
+// Throws: `Exception` if it is out of bounds.
+inline std::string_view load_string(std::string_view strings, const char* p)
+{
+    const auto offset{load<std::uint_least32_t>(p)};
+    const auto size{load<std::uint_least32_t>(p + 4)};
+
+    if (offset > strings.size() || size > strings.size() - offset)
+        throw_invalid("string out of bounds");
+
+    return strings.substr(offset, size);
+}
+
+// Returns: The bytes of the raw tile ids of `tile_ids` referred to by the tile
+//          layer `record`.
+// Throws: `Exception` if they are out of bounds or their count does not match
+//         the layer size.
+inline std::string_view load_tile_ids(
+    std::string_view tile_ids, const char* record)
+{
+    constexpr auto id_size{sizeof(std::uint_least32_t)};
+
+    const auto p{record + layer::tile_ids};
+    const auto index{load<std::uint_least32_t>(p)};
+    const auto count{load<std::uint_least32_t>(p + 4)};
+    const auto size{tile_ids.size() / id_size};
+
+    if (index > size || count > size - index)
+        throw_invalid("tile ids out of bounds");
+
+    const std::int_least64_t width{
+        load<std::int_least32_t>(record + layer::width)};
+    const std::int_least64_t height{
+        load<std::int_least32_t>(record + layer::height)};
+
+    if (width < 0 || height < 0 || count != width * height)
+        throw_invalid("tile ids do not match layer size");
+
+    return tile_ids.substr(index * id_size, count * id_size);
+}
+
+} // namespace tmxpp::impl::binary
+
+#endif // TMXPP_IMPL_BINARY_FORMAT_HPP
@@ -0,0 +1,30 @@
+#ifndef TMXPP_IMPL_COMPRESSION_HPP
+#define TMXPP_IMPL_COMPRESSION_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include <tmxpp/Data.hpp>
+
+namespace tmxpp::impl::compression {
+
+// Requires: `c != Data::Compression::none`.
+// Effects: Decodes the base64 `data` and decompresses it as `c` into `out`.
+//          Both steps are done a fixed-size block at a time, so the
+//          compressed bytes are never held in full.
+// Returns: The number of bytes written to `out`.
+// Throws: `Exception` if `data` is malformed or decompresses to more than
+//         `size` bytes.
+std::size_t inflate(
+    std::string_view data, Data::Compression c, unsigned char* out,
+    std::size_t size);
+
+// Requires: `c != Data::Compression::none`.
+// Returns: `in` compressed as `c`.
+// Throws: `Exception` in case of error.
+std::vector<unsigned char> deflate(
+    const unsigned char* in, std::size_t size, Data::Compression c);
+
+} // namespace tmxpp::impl::compression
+
+#endif // TMXPP_IMPL_COMPRESSION_HPP
@@ -0,0 +1,20 @@
+#ifndef TMXPP_IMPL_CSV_HPP
+#define TMXPP_IMPL_CSV_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace tmxpp::impl::csv {
+
+// Effects: Parses the unsigned 32-bit integers in `data`, separated by commas
+//          and whitespace, storing the first `size` of them into `out`.
+// Returns: The number of integers in `data`, or no value if it has other
+//          characters or an integer out of range.
+std::optional<std::size_t> parse_ids(
+    std::string_view data, std::uint_least32_t* out, std::size_t size) noexcept;
+
+} // namespace tmxpp::impl::csv
+
+#endif // TMXPP_IMPL_CSV_HPP
@@ -0,0 +1,34 @@
+#ifndef TMXPP_IMPL_LITTLE_ENDIAN_HPP
+#define TMXPP_IMPL_LITTLE_ENDIAN_HPP
+
+#include <cstdint>
+
+namespace tmxpp::impl {
+
+// Returns: `x` with its bytes swapped if the native byte order is not little
+//          endian, and `x` otherwise.
+// Notes: Converts in either direction.
+constexpr std::uint_least32_t little_endian(std::uint_least32_t x) noexcept
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return __builtin_bswap32(x);
+#else
+    return x;
+#endif
+}
+
+// Returns: `x` with its bytes swapped if the native byte order is not little
+//          endian, and `x` otherwise.
+// Notes: Converts in either direction.
+constexpr std::uint_least64_t little_endian(std::uint_least64_t x) noexcept
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return __builtin_bswap64(x);
+#else
+    return x;
+#endif
+}
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_LITTLE_ENDIAN_HPP
@@ -0,0 +1,70 @@
+#ifndef TMXPP_IMPL_PARALLEL_HPP
+#define TMXPP_IMPL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace tmxpp::impl {
+
+// Effects: Calls `f(i)` for each `i` in `[0, count)` on up to `threads`
+//          threads, including the calling thread. `0` `threads` means
+//          `std::thread::hardware_concurrency()`. Each thread takes the next
+//          `i` when done with its previous one.
+// Throws: The exception thrown by the call with the lowest `i`, after all calls
+//         finish.
+template <class Function>
+void parallel_for(std::size_t count, unsigned threads, Function f)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+
+    if (threads <= 1) {
+        for (std::size_t i{0}; i != count; ++i)
+            f(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::vector<std::exception_ptr> errors(count);
+
+    auto work = [&] {
+        for (auto i{next++}; i < count; i = next++) {
+            try {
+                f(i);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+
+    try {
+        while (pool.size() != threads - 1)
+            pool.emplace_back(work);
+    }
+    catch (const std::system_error&) {
+        // Make do with the threads started.
+    }
+
+    work();
+
+    for (auto& thread : pool)
+        thread.join();
+
+    for (auto& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_PARALLEL_HPP
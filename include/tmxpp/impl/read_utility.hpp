@@ -1,33 +1,31 @@
 #ifndef TMXPP_IMPL_READ_UTILITY_HPP
 #define TMXPP_IMPL_READ_UTILITY_HPP
 
-#include <ios>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
 #include <optional>
-#include <sstream>
 #include <string>
+#include <system_error>
 #include <string_view>
 #include <type_traits>
 #include <utility>
-#include <gsl/gsl>
-#include <gsl/string_span>
-#include <boost/lexical_cast.hpp>
-#include <boost/tokenizer.hpp>
 #include <range/v3/action/concepts.hpp>
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/begin_end.hpp>
-#include <range/v3/distance.hpp>
 #include <range/v3/range_concepts.hpp>
 #include <range/v3/range_traits.hpp>
+#include <range/v3/size.hpp>
 #include <range/v3/utility/concepts.hpp>
 #include <range/v3/utility/functional.hpp>
 #include <range/v3/utility/invoke.hpp>
-#include <range/v3/view/bounded.hpp>
 #include <range/v3/view/filter.hpp>
-#include <range/v3/view/transform.hpp>
 #include <jegp/utility.hpp>
 #include <tmxpp/Constrained.hpp>
 #include <tmxpp/Strong_typedef.hpp>
 #include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Model_resource.hpp>
 #include <tmxpp/impl/Xml.hpp>
 
 namespace tmxpp::impl {
@@ -59,17 +57,57 @@ struct detector<Op, T, std::void_t<Op<T>>> {
 template <template <class> class Op, class T>
 using detected_t = typename detector<Op, T>::type;
 
+// Returns: `s` as an arithmetic `T`, if all of `s` represents one in range.
+// Notes: A leading `+` is accepted. A `bool` is `0` or `1`, and a floating
+//        point is finite. Neither allocates nor depends on the locale.
+template <class T>
+std::optional<T> try_from_string(std::string_view s) noexcept
+{
+    static_assert(std::is_arithmetic_v<T>);
+
+    if (!s.empty() && s.front() == '+') {
+        s.remove_prefix(1);
+
+        if (!s.empty() && s.front() == '-')
+            return {};
+    }
+
+    if constexpr (std::is_same_v<T, bool>) {
+        if (s == "0")
+            return false;
+        if (s == "1")
+            return true;
+        return {};
+    }
+    else {
+        const auto last{s.data() + s.size()};
+
+        T num;
+        auto [end, error]{std::from_chars(s.data(), last, num)};
+
+        if (error != std::errc{} || end != last)
+            return {};
+
+        if constexpr (std::is_floating_point_v<T>)
+            if (!std::isfinite(num))
+                return {};
+
+        return num;
+    }
+}
+
 template <class T>
 struct From_string {
     // Returns: `s` as an `Integral`.
     // Throws: `Exception` if it could not be converted.
     CONCEPT_REQUIRES(ranges::Integral<T>())
-    T operator()(std::string_view s) try {
-        return boost::lexical_cast<T>(s);
-    }
-    catch (const boost::bad_lexical_cast& e) {
-        throw Exception{std::string{s} +
-                        " could not be converted to Integral. " + e.what()};
+    T operator()(std::string_view s)
+    {
+        if (auto num{try_from_string<T>(s)})
+            return *num;
+
+        throw Exception{
+            std::string{s} + " could not be converted to Integral."};
     }
 
     // Returns: `s` as a `T` floating point.
@@ -77,14 +115,11 @@ struct From_string {
     CONCEPT_REQUIRES(std::is_floating_point_v<T>)
     T operator()(std::string_view s)
     {
-        std::stringstream ss;
-        ss << std::noskipws << std::scientific << s;
-        T num;
-        ss >> num;
-        if (!ss || !ss.eof())
-            throw Exception{std::string{s} +
-                            " could not be converted to FloatingPoint."};
-        return num;
+        if (auto num{try_from_string<T>(s)})
+            return *num;
+
+        throw Exception{std::string{s} +
+                        " could not be converted to FloatingPoint."};
     }
 
     template <class Constrained = T>
@@ -125,8 +160,26 @@ auto children(
            });
 }
 
+// Returns: A copy of `s` which allocates from `Model_resource::get()`.
+std::pmr::string model_string(std::string_view s)
+{
+    return std::pmr::string{s, Model_resource::get()};
+}
+
+// Returns: An empty `Cont`, which allocates from `Model_resource::get()` if it
+//          uses a polymorphic allocator.
+template <class Cont>
+Cont model_container()
+{
+    if constexpr (std::is_constructible_v<Cont, std::pmr::memory_resource*>)
+        return Cont(Model_resource::get());
+    else
+        return Cont{};
+}
+
 // Requires: `Cont` is a STL `SequenceContainer`.
-// Returns: `rng` `trans`formed into the `Cont`.
+// Returns: `rng` `trans`formed into `model_container<Cont>()`.
+// Notes: `rng` is traversed once. Only a `ranges::SizedRange` is reserved for.
 template <
     class Cont, class Rng, class Transform,
     CONCEPT_REQUIRES_(
@@ -138,28 +191,15 @@ template <
             jegp::Value_type<Cont>>())>
 Cont transform(Rng rng, Transform trans)
 {
-    Cont container;
-    container.reserve(ranges::distance(rng));
+    auto container{model_container<Cont>()};
 
-    auto elements{rng | ranges::view::transform(trans) | ranges::view::bounded};
+    if constexpr (ranges::SizedRange<Rng>())
+        container.reserve(static_cast<std::size_t>(ranges::size(rng)));
 
-    CONCEPT_ASSERT(ranges::ReserveAndAssignable<
-                   Cont, decltype(ranges::begin(elements))>());
-    container.assign(ranges::begin(elements), ranges::end(elements));
-    return container;
-}
-
-// Returns: A `ranges::InputRange` of `std::string`s where the elements are the
-//          substrings in `to_tokenize` separated by the characters in
-//          `separators`.
-auto tokenize(
-    std::string_view to_tokenize, gsl::not_null<gsl::czstring<>> separators)
-{
-    using TokenizerFunction = boost::char_separator<char>;
-    using Tokenizer =
-        boost::tokenizer<TokenizerFunction, std::string_view::iterator>;
+    for (auto first{ranges::begin(rng)}; first != ranges::end(rng); ++first)
+        container.push_back(ranges::invoke(trans, *first));
 
-    return Tokenizer{to_tokenize, TokenizerFunction{separators}};
+    return container;
 }
 
 } // namespace tmxpp::impl
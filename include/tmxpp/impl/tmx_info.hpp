@@ -76,6 +76,8 @@ constexpr Xml::Attribute::Value data_encoding_csv{"csv"sv};
 constexpr Xml::Attribute::Value data_encoding_base64{"base64"sv};
 constexpr Xml::Attribute::Name data_compression{"compression"sv};
 constexpr Xml::Attribute::Value data_compression_zlib{"zlib"sv};
+constexpr Xml::Attribute::Value data_compression_gzip{"gzip"sv};
+constexpr Xml::Attribute::Value data_compression_zstd{"zstd"sv};
 
 constexpr Xml::Element::Name object_layer{"objectgroup"sv};
 constexpr Xml::Attribute::Name object_layer_color{"color"sv};
@@ -1,10 +1,9 @@
 #ifndef TMXPP_IMPL_TO_COLOR_HPP
 #define TMXPP_IMPL_TO_COLOR_HPP
 
+#include <array>
 #include <cstdint>
-#include <ios>
-#include <regex>
-#include <sstream>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tmxpp/Color.hpp>
@@ -15,49 +14,52 @@ namespace tmxpp::impl {
 
 namespace color {
 
-// Returns: `true` if `s` has the format of a TMX color, and `false` otherwise.
-// Notes: A TMX color has the format "#AARRGGBB", "#RRGGBB" or "RRGGBB".
-bool is_well_formatted(std::string_view s)
-{
-    static const std::regex format{"((#[[:xdigit:]]{2})|#)?[[:xdigit:]]{6}",
-                                   std::regex::nosubs};
-
-    return std::regex_match(s.begin(), s.end(), format);
-}
-
-constexpr std::string_view format_with_alpha{"#AARRGGBB", 9};
+// The value of `hex_digits` for characters which are not hexadecimal digits.
+constexpr unsigned char not_hex_digit{0xFF};
 
-// Requires: `is_well_formatted(color)`
-// Returns: The hexadecimal substring in `color`.
-constexpr std::string_view hex_substr(std::string_view color) noexcept
+constexpr std::array<unsigned char, 256> make_hex_digits() noexcept
 {
-    return color[0] == format_with_alpha[0] ? color.substr(1) : color;
+    std::array<unsigned char, 256> table{};
+
+    for (auto& digit : table)
+        digit = not_hex_digit;
+    for (unsigned char i{0}; i != 10; ++i)
+        table['0' + i] = i;
+    for (unsigned char i{0}; i != 6; ++i) {
+        table['a' + i] = 10 + i;
+        table['A' + i] = 10 + i;
+    }
+
+    return table;
 }
 
+constexpr auto hex_digits{make_hex_digits()};
+
 using Channels = std::uint_least32_t;
 
-// Requires: `is_well_formatted(color)`
-// Returns: `hex_substr(color)` as `Channels`.
-// Throws: `Exception` if it could not be converted.
-Channels to_channels(std::string_view color)
+// Returns: The hexadecimal number `hex` as `Channels`, if `hex` only has
+//          hexadecimal digits.
+// Notes: Only the result is branched on.
+constexpr std::optional<Channels> to_channels(std::string_view hex) noexcept
 {
-    std::stringstream ss;
-    ss << std::noskipws << std::hex << hex_substr(color);
-    Channels num;
-    ss >> num;
-    if (!ss || !ss.eof())
-        throw Exception{"Hexadecimal " + std::string{hex_substr(color)} +
-                        " could not be converted to Channels."};
-    return num;
-}
+    Channels channels{0};
+    unsigned char digits{0};
 
-// Requires: `is_well_formatted(color)`
-// Returns: `true` if `color` has an alpha channel, and `false` otherwise.
-constexpr bool has_alpha(std::string_view color) noexcept
-{
-    return color.size() == format_with_alpha.size();
+    for (auto c : hex) {
+        const auto digit{hex_digits[static_cast<unsigned char>(c)]};
+
+        digits |= digit;
+        channels = channels << 4 | (digit & 0x0F);
+    }
+
+    if (digits & 0xF0)
+        return {};
+    return channels;
 }
 
+// Returns: `color` as a `Color`, with an opaque black for an empty `color`.
+// Throws: `Exception` if `color` is not empty and does not have the format of
+//         a TMX color, "#AARRGGBB", "#RRGGBB" or "RRGGBB".
 Color to_color(std::string_view color)
 {
     constexpr Color::Channel default_alpha{255};
@@ -66,17 +68,24 @@ Color to_color(std::string_view color)
     if (color.empty())
         return default_;
 
-    if (!is_well_formatted(color))
-        throw Exception{"Color with bad format: " + std::string{color}};
+    const bool has_hash{color.front() == '#'};
+    const auto hex{color.substr(has_hash)};
+    const bool has_alpha{has_hash && hex.size() == 8};
 
-    auto channels{to_channels(color)};
+    std::optional<Channels> channels;
+
+    if (hex.size() == 6 || has_alpha)
+        channels = to_channels(hex);
+
+    if (!channels)
+        throw Exception{"Color with bad format: " + std::string{color}};
 
     return {
-        has_alpha(color) ? static_cast<Color::Channel>((channels >> 24) & 0xFF)
-                         : default_alpha,
-        static_cast<Color::Channel>((channels >> 16) & 0xFF),
-        static_cast<Color::Channel>((channels >> 8) & 0xFF),
-        static_cast<Color::Channel>(channels & 0xFF),
+        has_alpha ? static_cast<Color::Channel>((*channels >> 24) & 0xFF)
+                  : default_alpha,
+        static_cast<Color::Channel>((*channels >> 16) & 0xFF),
+        static_cast<Color::Channel>((*channels >> 8) & 0xFF),
+        static_cast<Color::Channel>(*channels & 0xFF),
     };
 }
 
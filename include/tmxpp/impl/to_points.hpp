@@ -0,0 +1,53 @@
+#ifndef TMXPP_IMPL_TO_POINTS_HPP
+#define TMXPP_IMPL_TO_POINTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tmxpp/Object.hpp>
+#include <tmxpp/Point.hpp>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/read_utility.hpp>
+
+namespace tmxpp::impl {
+
+// Returns: The points in `points`, which are "x,y" pairs separated by spaces.
+// Throws: `Exception` if a point has a bad format.
+// Notes: `points` is traversed once, without intermediate containers.
+Object::Polygon::Points to_points(std::string_view points)
+{
+    using Coordinate = type_safe::underlying_type<Point::Coordinate>;
+
+    auto result{model_container<Object::Polygon::Points>()};
+
+    for (std::size_t first{0};;) {
+        first = points.find_first_not_of(' ', first);
+
+        if (first == std::string_view::npos)
+            return result;
+
+        const auto last{std::min(points.find(' ', first), points.size())};
+        const auto point{points.substr(first, last - first)};
+        const auto comma{point.find(',')};
+
+        std::optional<Coordinate> x;
+        std::optional<Coordinate> y;
+
+        if (comma != std::string_view::npos) {
+            x = try_from_string<Coordinate>(point.substr(0, comma));
+            y = try_from_string<Coordinate>(point.substr(comma + 1));
+        }
+
+        if (!x || !y)
+            throw Exception{"Bad poly point: " + std::string{point}};
+
+        result.push_back({Point::Coordinate{*x}, Point::Coordinate{*y}});
+        first = last;
+    }
+}
+
+} // namespace tmxpp::impl
+
+#endif // TMXPP_IMPL_TO_POINTS_HPP
@@ -1,37 +1,28 @@
 #ifndef TMXPP_IMPL_TO_STRING_COLOR_HPP
 #define TMXPP_IMPL_TO_STRING_COLOR_HPP
 
-#include <algorithm>
-#include <cstdint>
-#include <iomanip>
-#include <sstream>
 #include <string>
 #include <tmxpp/Color.hpp>
 #include <tmxpp/exceptions.hpp>
 
 namespace tmxpp::impl {
 
+// Returns: `c` in the format "#aarrggbb".
+// Throws: `Exception` if a channel has more than 8 bits.
 std::string to_string(Color c)
 {
-    auto checked = [](Color::Channel c) {
-        if (c > 255)
-            throw Exception{"Color::Channel value over 8 bits."};
-        return c;
-    };
-
-    using Channels = std::uint_least32_t;
+    constexpr char hex_digits[]{"0123456789abcdef"};
 
-    Channels channels{static_cast<Channels>(checked(c.a)) << 24 |
-                      static_cast<Channels>(checked(c.r)) << 16 |
-                      static_cast<Channels>(checked(c.g)) << 8 | checked(c.b)};
+    std::string s(1 + 4 * 2, '#');
+    auto out{s.data() + 1};
 
-    std::stringstream ss;
-    ss << std::hex << channels;
-
-    auto hex{ss.str()};
+    for (auto channel : {c.a, c.r, c.g, c.b}) {
+        if (channel > 255)
+            throw Exception{"Color::Channel value over 8 bits."};
 
-    std::string s{"#00000000"};
-    std::copy_backward(hex.begin(), hex.end(), s.end());
+        *out++ = hex_digits[channel >> 4];
+        *out++ = hex_digits[channel & 0x0F];
+    }
 
     return s;
 }
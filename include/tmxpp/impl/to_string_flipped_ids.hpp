@@ -1,34 +1,76 @@
 #ifndef TMXPP_IMPL_TO_STRING_FLIPPED_IDS
 #define TMXPP_IMPL_TO_STRING_FLIPPED_IDS
 
+#include <charconv>
+#include <cstddef>
 #include <string>
-#include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/view/chunk.hpp>
-#include <range/v3/view/intersperse.hpp>
-#include <range/v3/view/join.hpp>
-#include <range/v3/view/transform.hpp>
 #include <tmxpp/Data.hpp>
 #include <tmxpp/Size.hpp>
 #include <tmxpp/exceptions.hpp>
-#include <tmxpp/impl/Raw_tile_id.hpp>
+#include <tmxpp/impl/base64.hpp>
+#include <tmxpp/impl/compression.hpp>
+#include <tmxpp/impl/little_endian.hpp>
 
 namespace tmxpp::impl {
 
-std::string to_string(const Data::Flipped_ids& ids, iSize sz)
+void check_size(const Data::Flipped_ids& ids, iSize sz)
 {
-    if (ids.size() / *sz.h - *sz.w != 0)
+    if (ids.size() != static_cast<std::size_t>(*sz.w) * *sz.h)
         throw Exception{"Data size does not match layer size."};
+}
+
+std::string to_string(const Data::Flipped_ids& ids, iSize sz)
+{
+    check_size(ids, sz);
+
+    // A raw tile id has at most 10 digits, a comma and a newline after it.
+    constexpr std::size_t max_id_size{10 + 2};
+
+    const auto& raw_ids{ids.raw()};
+    const auto w{static_cast<std::size_t>(*sz.w)};
+
+    std::string data(1 + raw_ids.size() * max_id_size + 1, '\n');
+    auto out{data.data() + 1};
+    const auto last{data.data() + data.size()};
+
+    for (auto row{raw_ids.data()}, end{row + raw_ids.size()}; row != end;
+         row += w) {
+        for (std::size_t x{0}; x != w; ++x) {
+            out    = std::to_chars(out, last, row[x]).ptr;
+            *out++ = ',';
+        }
+        *out++ = '\n';
+    }
+
+    // The last raw tile id is followed by a newline instead of a comma.
+    if (!raw_ids.empty())
+        *(--out - 1) = '\n';
+    else
+        *out++ = '\n';
+
+    data.resize(static_cast<std::size_t>(out - data.data()));
+    return data;
+}
+
+std::string to_base64(
+    const Data::Flipped_ids& ids, iSize sz, Data::Compression c)
+{
+    check_size(ids, sz);
+
+    auto raw_ids{ids.raw()};
+
+    for (auto& id : raw_ids)
+        id = little_endian(id);
+
+    const auto bytes{reinterpret_cast<const unsigned char*>(raw_ids.data())};
+    const auto size{raw_ids.size() * sizeof(raw_ids[0])};
+
+    if (c == Data::Compression::none)
+        return '\n' + base64::encode(bytes, size) + '\n';
 
-    auto data{ids | ranges::view::transform([](auto id) {
-                  if (id)
-                      return std::to_string(get(to_raw(*id)));
-                  return std::string{'0'};
-              }) |
-              ranges::view::intersperse(std::string{','}) |
-              ranges::view::chunk(2 * *sz.w) |
-              ranges::view::join(std::string{'\n'})};
+    auto compressed{compression::deflate(bytes, size, c)};
 
-    return ranges::accumulate(data, std::string{'\n'}) + '\n';
+    return '\n' + base64::encode(compressed.data(), compressed.size()) + '\n';
 }
 
 } // namespace tmxpp::impl
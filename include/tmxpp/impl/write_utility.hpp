@@ -1,28 +1,31 @@
 #ifndef TMXPP_IMPL_WRITE_UTILITY_HPP
 #define TMXPP_IMPL_WRITE_UTILITY_HPP
 
+#include <charconv>
+#include <cstddef>
+#include <iterator>
 #include <optional>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <type_traits>
-#include <boost/lexical_cast.hpp>
 #include <tmxpp/Constrained.hpp>
 #include <tmxpp/File.hpp>
 #include <tmxpp/Strong_typedef.hpp>
-#include <tmxpp/exceptions.hpp>
 #include <tmxpp/impl/Xml.hpp>
+#include <tmxpp/impl/Xml_writer.hpp>
 #include <tmxpp/impl/to_string_color.hpp>
 
 namespace tmxpp::impl {
 
-void add(Xml::Element elem, Xml::Attribute::Name name, std::string_view value)
+void add(
+    Xml_writer::Element elem, Xml::Attribute::Name name,
+    std::string_view value)
 {
     elem.add(name, Xml::Attribute::Value{value});
 }
 
 void non_empty_add(
-    Xml::Element elem, Xml::Attribute::Name name, std::string_view value)
+    Xml_writer::Element elem, Xml::Attribute::Name name, std::string_view value)
 {
     if (!value.empty())
         add(elem, name, value);
@@ -30,39 +33,58 @@ void non_empty_add(
 
 template <class File_, class = std::enable_if_t<std::is_same_v<File_, File>>>
 void non_empty_add(
-    Xml::Element elem, Xml::Attribute::Name name, const File_& value)
+    Xml_writer::Element elem, Xml::Attribute::Name name, const File_& value)
 {
     if (!value.empty())
         add(elem, name, value.string());
 }
 
+// A number formatted in place, without allocating.
+class Number_string {
+public:
+    // Effects: Formats `num` in the shortest form which reads back as `num`.
+    template <
+        class Arithmetic,
+        class = std::enable_if_t<std::is_arithmetic_v<Arithmetic>>>
+    explicit Number_string(Arithmetic num) noexcept
+    {
+        const auto last{[&] {
+            if constexpr (std::is_same_v<Arithmetic, bool>)
+                return std::to_chars(chars, std::end(chars), int{num}).ptr;
+            else
+                return std::to_chars(chars, std::end(chars), num).ptr;
+        }()};
+
+        size = static_cast<std::size_t>(last - chars);
+    }
+
+    operator std::string_view() const noexcept
+    {
+        return {chars, size};
+    }
+
+private:
+    // Fits the longest `double`, "-2.2250738585072014e-308".
+    char chars[32];
+    std::size_t size;
+};
+
 template <
     class Arithmetic,
     class = std::enable_if_t<std::is_arithmetic_v<Arithmetic>>>
-std::string to_string(Arithmetic num) try {
-    return boost::lexical_cast<std::string>(num);
-}
-catch (const boost::bad_lexical_cast& e) {
-    throw Exception{
-        std::string{"Could not convert Arithmetic to std::string. "} +
-        e.what()};
-}
-
-std::string to_string(double d)
+Number_string to_string(Arithmetic num) noexcept
 {
-    std::stringstream ss;
-    ss << d;
-    return ss.str();
+    return Number_string{num};
 }
 
 template <class T, class C>
-std::string to_string(const Constrained<T, C>& x)
+auto to_string(const Constrained<T, C>& x)
 {
     return to_string(*x);
 }
 
 template <class T, class P>
-std::string to_string(Strong_typedef<T, P> x)
+auto to_string(Strong_typedef<T, P> x)
 {
     return to_string(get(x));
 }
@@ -70,20 +92,23 @@ std::string to_string(Strong_typedef<T, P> x)
 template <
     class T,
     class = std::enable_if_t<!std::is_convertible_v<T, std::string_view>>>
-void add(Xml::Element elem, Xml::Attribute::Name name, T value)
+void add(Xml_writer::Element elem, Xml::Attribute::Name name, T value)
 {
     add(elem, name, to_string(value));
 }
 
 template <class T, class C>
 void add(
-    Xml::Element elem, Xml::Attribute::Name name, const Constrained<T, C>& x)
+    Xml_writer::Element elem, Xml::Attribute::Name name,
+    const Constrained<T, C>& x)
 {
     return add(elem, name, *x);
 }
 
 template <class T>
-void add(Xml::Element elem, Xml::Attribute::Name name, std::optional<T> value)
+void add(
+    Xml_writer::Element elem, Xml::Attribute::Name name,
+    std::optional<T> value)
 {
     if (value)
         add(elem, name, *value);
@@ -100,7 +125,7 @@ struct Default {
 
 template <class T>
 void non_default_add(
-    Xml::Element elem, Xml::Attribute::Name name, T value,
+    Xml_writer::Element elem, Xml::Attribute::Name name, T value,
     Default<T> def = Default{T{}})
 {
     if (value != def.value)
@@ -109,7 +134,7 @@ void non_default_add(
 
 template <class T, class C>
 void non_default_add(
-    Xml::Element elem, Xml::Attribute::Name name,
+    Xml_writer::Element elem, Xml::Attribute::Name name,
     const Constrained<T, C>& value, Default<T> def = Default{T{}})
 {
     if (*value != def.value)
@@ -117,7 +142,7 @@ void non_default_add(
 }
 
 template <class T>
-void write(const std::optional<T>& value, Xml::Element elem)
+void write(const std::optional<T>& value, Xml_writer::Element elem)
 {
     if (value)
         write(*value, elem);
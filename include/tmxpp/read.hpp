@@ -2,20 +2,65 @@
 #define TMXPP_READ_HPP
 
 #include <experimental/filesystem>
+#include <functional>
+#include <memory_resource>
+#include <string_view>
 #include <tmxpp/File.hpp>
 #include <tmxpp/Image_collection.hpp>
+#include <tmxpp/Layer.hpp>
 #include <tmxpp/Map.hpp>
+#include <tmxpp/Object.hpp>
+#include <tmxpp/Object_layer.hpp>
+#include <tmxpp/Strong_typedef.hpp>
 #include <tmxpp/Tile_id.hpp>
 #include <tmxpp/Tile_set.hpp>
 
 namespace tmxpp {
 
-Map read_tmx(const std::experimental::filesystem::path&);
+using Document = Strong_typedef<std::string_view, struct _document>;
+using In_situ_document = Strong_typedef<char*, struct _in_situ_document>;
+
+using Tsx_resolver = std::function<Map::Tile_set(Global_tile_id, File)>;
+
+class Tsx_cache;
+
+struct Read_options {
+    bool lazy_tile_data{};
+    unsigned threads{1};
+    Tsx_cache* tsx_cache{};
+    std::pmr::memory_resource* memory_resource{};
+};
+
+struct Tmx_callbacks {
+    std::function<void(Map)> map;
+    std::function<void(Map::Tile_set)> tile_set;
+    std::function<bool(const Layer&)> select_layer;
+    std::function<void(Map::Layer)> layer;
+    std::function<void(const Object_layer&, Object)> object;
+};
+
+Map read_tmx(
+    const std::experimental::filesystem::path&, const Read_options& = {});
+Map read_tmx(Document, const Tsx_resolver& = {}, const Read_options& = {});
+Map read_tmx(
+    In_situ_document, const Tsx_resolver& = {}, const Read_options& = {});
+
+void read_tmx(
+    const std::experimental::filesystem::path&, const Tmx_callbacks&,
+    const Read_options& = {});
+void read_tmx(
+    Document, const Tmx_callbacks&, const Tsx_resolver& = {},
+    const Read_options& = {});
+void read_tmx(
+    In_situ_document, const Tmx_callbacks&, const Tsx_resolver& = {},
+    const Read_options& = {});
 
 Map::Tile_set read_tsx(
     Global_tile_id first_id, File tsx,
     const std::experimental::filesystem::path& base =
         std::experimental::filesystem::current_path());
+Map::Tile_set read_tsx(Global_tile_id first_id, File tsx, Document);
+Map::Tile_set read_tsx(Global_tile_id first_id, File tsx, In_situ_document);
 Tile_set read_tile_set(
     Global_tile_id first_id, File tsx,
     const std::experimental::filesystem::path& base =
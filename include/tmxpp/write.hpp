@@ -2,14 +2,26 @@
 #define TMXPP_WRITE_HPP
 
 #include <experimental/filesystem>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <tmxpp/File.hpp>
 #include <tmxpp/Image_collection.hpp>
 #include <tmxpp/Map.hpp>
 #include <tmxpp/Tile_set.hpp>
 
 namespace tmxpp {
 
+using Sink = std::function<void(std::string_view)>;
+
+using Tsx_sink_resolver = std::function<Sink(const File&)>;
+
 void write(const Map&, const std::experimental::filesystem::path&);
+void write(const Map&, const Sink&, const Tsx_sink_resolver& = {});
+void write(const Map&, std::ostream&, const Tsx_sink_resolver& = {});
+std::string to_tmx(const Map&, const Tsx_sink_resolver& = {});
 
 template <class Tile_set_>
 std::enable_if_t<
@@ -19,6 +31,25 @@ std::enable_if_t<
 write(
     const Tile_set_&, const std::experimental::filesystem::path& base =
                           std::experimental::filesystem::current_path());
+template <class Tile_set_>
+std::enable_if_t<
+    std::is_same_v<Tile_set_, Map::Tile_set> ||
+    std::is_same_v<Tile_set_, Tile_set> ||
+    std::is_same_v<Tile_set_, Image_collection>>
+write(const Tile_set_&, const Sink&);
+template <class Tile_set_>
+std::enable_if_t<
+    std::is_same_v<Tile_set_, Map::Tile_set> ||
+    std::is_same_v<Tile_set_, Tile_set> ||
+    std::is_same_v<Tile_set_, Image_collection>>
+write(const Tile_set_&, std::ostream&);
+template <class Tile_set_>
+std::enable_if_t<
+    std::is_same_v<Tile_set_, Map::Tile_set> ||
+    std::is_same_v<Tile_set_, Tile_set> ||
+    std::is_same_v<Tile_set_, Image_collection>,
+    std::string>
+to_tsx(const Tile_set_&);
 
 } // namespace tmxpp
 
@@ -0,0 +1,631 @@
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <tmxpp/Map_view.hpp>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Mapped_file.hpp>
+#include <tmxpp/impl/binary_format.hpp>
+
+namespace tmxpp {
+
+namespace impl {
+
+using namespace binary;
+
+using u8  = std::uint_least8_t;
+using u32 = std::uint_least32_t;
+using i32 = std::int_least32_t;
+
+// Constructs the views of a binary TMX.
+struct Binary_view_access {
+    template <class View>
+    static View view(const Binary_sections& sections, const char* record)
+    {
+        return View{sections, record};
+    }
+
+    // Returns: A view of the array at `field` of `record`, of elements of
+    //          `size` bytes.
+    // Throws: `Exception` if the array is out of bounds.
+    template <class T>
+    static Array_view<T> array(
+        const Binary_sections& sections, const char* record,
+        std::size_t field, std::size_t size)
+    {
+        const auto count{load<u32>(record + field + 4)};
+
+        return {sections,
+                load_records(
+                    sections.records, load<u32>(record + field), count, size),
+                count, size};
+    }
+
+    static Tile_ids_view tile_ids(
+        const Binary_sections& sections, const char* record)
+    {
+        const auto bytes{load_tile_ids(sections.tile_ids, record)};
+
+        return {bytes.data(), bytes.size() / sizeof(Tile_ids_view::raw_type)};
+    }
+};
+
+namespace {
+
+Pixels load_pixels(const char* record, std::size_t field) noexcept
+{
+    return Pixels{load<double>(record + field)};
+}
+
+Color load_color(const char* record, std::size_t field) noexcept
+{
+    return {load<u8>(record + field), load<u8>(record + field + 1),
+            load<u8>(record + field + 2), load<u8>(record + field + 3)};
+}
+
+pxSize load_pxsize(const char* record, std::size_t width, std::size_t height)
+{
+    return {pxSize::Dimension{load_pixels(record, width)},
+            pxSize::Dimension{load_pixels(record, height)}};
+}
+
+iSize load_isize(const char* record, std::size_t width, std::size_t height)
+{
+    return {iSize::Dimension{load<i32>(record + width)},
+            iSize::Dimension{load<i32>(record + height)}};
+}
+
+Offset load_offset(const char* record, std::size_t x, std::size_t y) noexcept
+{
+    return {load_pixels(record, x), load_pixels(record, y)};
+}
+
+Properties_view load_properties(
+    const Binary_sections& sections, const char* record, std::size_t field)
+{
+    return Binary_view_access::array<Property_view>(
+        sections, record, field, property::size);
+}
+
+} // namespace
+
+template <>
+Property_view binary_element<Property_view>(
+    const Binary_sections& sections, const char* record)
+{
+    return Binary_view_access::view<Property_view>(sections, record);
+}
+
+template <>
+Frame binary_element<Frame>(const Binary_sections&, const char* record)
+{
+    return {Local_tile_id{load<i32>(record + frame::id)},
+            Non_negative<Frame::Duration>{
+                Frame::Duration{load<i32>(record + frame::duration)}}};
+}
+
+template <>
+Point binary_element<Point>(const Binary_sections&, const char* record)
+{
+    return {load_pixels(record, point::x), load_pixels(record, point::y)};
+}
+
+template <>
+Object_view binary_element<Object_view>(
+    const Binary_sections& sections, const char* record)
+{
+    return Binary_view_access::view<Object_view>(sections, record);
+}
+
+template <>
+Tile_view binary_element<Tile_view>(
+    const Binary_sections& sections, const char* record)
+{
+    return Binary_view_access::view<Tile_view>(sections, record);
+}
+
+template <>
+Image_collection_tile_view binary_element<Image_collection_tile_view>(
+    const Binary_sections& sections, const char* record)
+{
+    return Binary_view_access::view<Image_collection_tile_view>(
+        sections, record);
+}
+
+template <>
+Map_view::Tile_set binary_element<Map_view::Tile_set>(
+    const Binary_sections& sections, const char* record)
+{
+    switch (load<u8>(record + tile_set::kind)) {
+    case 0: return Binary_view_access::view<Tile_set_view>(sections, record);
+    case 1:
+        return Binary_view_access::view<Image_collection_view>(
+            sections, record);
+    default: throw_invalid("tile set kind out of range");
+    }
+}
+
+template <>
+Map_view::Layer binary_element<Map_view::Layer>(
+    const Binary_sections& sections, const char* record)
+{
+    switch (load<u8>(record + layer::kind)) {
+    case 0: return Binary_view_access::view<Tile_layer_view>(sections, record);
+    case 1:
+        return Binary_view_access::view<Object_layer_view>(sections, record);
+    case 2:
+        return Binary_view_access::view<Image_layer_view>(sections, record);
+    default: throw_invalid("layer kind out of range");
+    }
+}
+
+} // namespace impl
+
+using namespace impl::binary;
+
+using impl::u32;
+using impl::u8;
+using impl::i32;
+
+// Tile_ids_view ---------------------------------------------------------------
+
+Data::Flipped_ids Tile_ids_view::to_flipped_ids() const
+{
+    std::vector<raw_type> raw_ids(size_);
+    if (size_ != 0)
+        std::memcpy(raw_ids.data(), first_, size_ * sizeof(raw_type));
+
+    for (auto& id : raw_ids)
+        id = impl::little_endian(id);
+
+    return Data::Flipped_ids{std::move(raw_ids)};
+}
+
+// Property_view ---------------------------------------------------------------
+
+std::string_view Property_view::name() const
+{
+    return load_string(sections_.strings, record_ + property::name);
+}
+
+auto Property_view::value() const -> Value
+{
+    const auto value{record_ + property::value};
+
+    switch (load<u8>(record_ + property::kind)) {
+    case 0: return load_string(sections_.strings, value);
+    case 1: return int{load<i32>(value)};
+    case 2: return load<double>(value);
+    case 3: return load<u8>(value) != 0;
+    case 4: return impl::load_color(value, 0);
+    case 5: return File_view{load_string(sections_.strings, value)};
+    default: throw_invalid("property kind out of range");
+    }
+}
+
+// Image_view ------------------------------------------------------------------
+
+std::string_view Image_view::source() const
+{
+    return load_string(sections_.strings, record_ + image::source);
+}
+
+std::optional<Color> Image_view::transparent() const
+{
+    if (load<u8>(record_ + image::flags) & image::has_transparent)
+        return impl::load_color(record_, image::transparent);
+    return {};
+}
+
+std::optional<pxSize> Image_view::size() const
+{
+    if (load<u8>(record_ + image::flags) & image::has_size)
+        return impl::load_pxsize(record_, image::width, image::height);
+    return {};
+}
+
+// Object_view -----------------------------------------------------------------
+
+Unique_id Object_view::unique_id() const
+{
+    return Unique_id{Non_negative<int>{load<i32>(record_ + object::unique_id)}};
+}
+
+std::string_view Object_view::name() const
+{
+    return load_string(sections_.strings, record_ + object::name);
+}
+
+std::string_view Object_view::type() const
+{
+    return load_string(sections_.strings, record_ + object::type);
+}
+
+Point Object_view::position() const
+{
+    return {impl::load_pixels(record_, object::x),
+            impl::load_pixels(record_, object::y)};
+}
+
+auto Object_view::shape() const -> std::optional<Shape>
+{
+    const auto points{[this] {
+        return impl::Binary_view_access::array<Point>(
+            sections_, record_, object::points, point::size);
+    }};
+
+    switch (load<u8>(record_ + object::shape)) {
+    case 0: return {};
+    case 1:
+        return Object::Rectangle{
+            impl::load_pxsize(record_, object::width, object::height)};
+    case 2:
+        return Object::Ellipse{
+            impl::load_pxsize(record_, object::width, object::height)};
+    case 3: return Polygon{points()};
+    case 4: return Polyline{points()};
+    default: throw_invalid("object shape out of range");
+    }
+}
+
+Degrees Object_view::clockwise_rotation() const
+{
+    return Degrees{load<double>(record_ + object::clockwise_rotation)};
+}
+
+std::optional<Global_tile_id> Object_view::global_id() const
+{
+    if (auto id{load<i32>(record_ + object::global_id)})
+        return Global_tile_id{id};
+    return {};
+}
+
+bool Object_view::visible() const
+{
+    return load<u8>(record_ + object::visible) != 0;
+}
+
+Properties_view Object_view::properties() const
+{
+    return impl::load_properties(sections_, record_, object::properties);
+}
+
+// Layer_view ------------------------------------------------------------------
+
+std::string_view Layer_view::name() const
+{
+    return load_string(sections_.strings, record_ + layer::name);
+}
+
+Unit_interval Layer_view::opacity() const
+{
+    return Unit_interval{load<double>(record_ + layer::opacity)};
+}
+
+bool Layer_view::visible() const
+{
+    return load<u8>(record_ + layer::visible) != 0;
+}
+
+Offset Layer_view::offset() const
+{
+    return impl::load_offset(record_, layer::offset_x, layer::offset_y);
+}
+
+Properties_view Layer_view::properties() const
+{
+    return impl::load_properties(sections_, record_, layer::properties);
+}
+
+// Tile_layer_view -------------------------------------------------------------
+
+iSize Tile_layer_view::size() const
+{
+    return impl::load_isize(record_, layer::width, layer::height);
+}
+
+Data::Format Tile_layer_view::format() const
+{
+    return Data::Format{
+        to_enum(load<u8>(record_ + layer::encoding), Data::Encoding::base64),
+        to_enum(
+            load<u8>(record_ + layer::compression), Data::Compression::zstd)};
+}
+
+Tile_ids_view Tile_layer_view::tile_ids() const
+{
+    return impl::Binary_view_access::tile_ids(sections_, record_);
+}
+
+// Object_layer_view -----------------------------------------------------------
+
+std::optional<Color> Object_layer_view::color() const
+{
+    if (load<u8>(record_ + layer::object_flags) & layer::has_color)
+        return impl::load_color(record_, layer::color);
+    return {};
+}
+
+Object_layer::Draw_order Object_layer_view::draw_order() const
+{
+    return to_enum(
+        load<u8>(record_ + layer::draw_order),
+        Object_layer::Draw_order::index);
+}
+
+auto Object_layer_view::objects() const -> Objects
+{
+    return impl::Binary_view_access::array<Object_view>(
+        sections_, record_, layer::objects, object::size);
+}
+
+// Image_layer_view ------------------------------------------------------------
+
+std::optional<Image_view> Image_layer_view::image() const
+{
+    if (load<u8>(record_ + layer::image_flags) & layer::has_image)
+        return impl::Binary_view_access::view<Image_view>(
+            sections_, record_ + layer::image);
+    return {};
+}
+
+// Tile_view -------------------------------------------------------------------
+
+Local_tile_id Tile_view::id() const
+{
+    return Local_tile_id{load<i32>(record_ + tile::id)};
+}
+
+Properties_view Tile_view::properties() const
+{
+    return impl::load_properties(sections_, record_, tile::properties);
+}
+
+std::optional<Object_layer_view> Tile_view::collision_shape() const
+{
+    const auto count{load<u32>(record_ + tile::collision_shape + 4)};
+
+    if (count == 0)
+        return {};
+    if (count != 1)
+        throw_invalid("more than one collision shape");
+
+    const auto shape{load_records(
+        sections_.records, load<u32>(record_ + tile::collision_shape), 1,
+        layer::size)};
+
+    if (load<u8>(shape + layer::kind) != 1)
+        throw_invalid("collision shape is not an object layer");
+
+    return impl::Binary_view_access::view<Object_layer_view>(sections_, shape);
+}
+
+Array_view<Frame> Tile_view::animation() const
+{
+    return impl::Binary_view_access::array<Frame>(
+        sections_, record_, tile::animation, frame::size);
+}
+
+Image_view Image_collection_tile_view::image() const
+{
+    return impl::Binary_view_access::view<Image_view>(
+        sections_, record_ + tile::image);
+}
+
+// Tile_set_view ---------------------------------------------------------------
+
+Global_tile_id Tile_set_view::first_id() const
+{
+    return Global_tile_id{load<i32>(record_ + tile_set::first_id)};
+}
+
+std::string_view Tile_set_view::tsx() const
+{
+    return load_string(sections_.strings, record_ + tile_set::tsx);
+}
+
+std::string_view Tile_set_view::name() const
+{
+    return load_string(sections_.strings, record_ + tile_set::name);
+}
+
+pxSize Tile_set_view::tile_size() const
+{
+    return impl::load_pxsize(
+        record_, tile_set::tile_width, tile_set::tile_height);
+}
+
+Non_negative<Pixels> Tile_set_view::spacing() const
+{
+    return Non_negative<Pixels>{impl::load_pixels(record_, tile_set::spacing)};
+}
+
+Non_negative<Pixels> Tile_set_view::margin() const
+{
+    return Non_negative<Pixels>{impl::load_pixels(record_, tile_set::margin)};
+}
+
+iSize Tile_set_view::size() const
+{
+    return impl::load_isize(record_, tile_set::columns, tile_set::rows);
+}
+
+Offset Tile_set_view::tile_offset() const
+{
+    return impl::load_offset(
+        record_, tile_set::tile_offset_x, tile_set::tile_offset_y);
+}
+
+Properties_view Tile_set_view::properties() const
+{
+    return impl::load_properties(sections_, record_, tile_set::properties);
+}
+
+Image_view Tile_set_view::image() const
+{
+    return impl::Binary_view_access::view<Image_view>(
+        sections_, record_ + tile_set::image);
+}
+
+auto Tile_set_view::tiles() const -> Tiles
+{
+    return impl::Binary_view_access::array<Tile_view>(
+        sections_, record_, tile_set::tiles, tile::size);
+}
+
+// Image_collection_view -------------------------------------------------------
+
+Global_tile_id Image_collection_view::first_id() const
+{
+    return Global_tile_id{load<i32>(record_ + tile_set::first_id)};
+}
+
+std::string_view Image_collection_view::tsx() const
+{
+    return load_string(sections_.strings, record_ + tile_set::tsx);
+}
+
+std::string_view Image_collection_view::name() const
+{
+    return load_string(sections_.strings, record_ + tile_set::name);
+}
+
+pxSize Image_collection_view::max_tile_size() const
+{
+    return impl::load_pxsize(
+        record_, tile_set::tile_width, tile_set::tile_height);
+}
+
+Non_negative<int> Image_collection_view::tile_count() const
+{
+    return Non_negative<int>{load<i32>(record_ + tile_set::tile_count)};
+}
+
+Non_negative<int> Image_collection_view::columns() const
+{
+    return Non_negative<int>{load<i32>(record_ + tile_set::columns)};
+}
+
+Offset Image_collection_view::tile_offset() const
+{
+    return impl::load_offset(
+        record_, tile_set::tile_offset_x, tile_set::tile_offset_y);
+}
+
+Properties_view Image_collection_view::properties() const
+{
+    return impl::load_properties(sections_, record_, tile_set::properties);
+}
+
+auto Image_collection_view::tiles() const -> Tiles
+{
+    return impl::Binary_view_access::array<Image_collection_tile_view>(
+        sections_, record_, tile_set::tiles, tile::size);
+}
+
+// Map_view --------------------------------------------------------------------
+
+Map_view::Map_view(std::string_view binary)
+  : sections_{impl::binary::find_sections(binary)}
+  , record_{load_records(sections_.records, 0, 1, map::size)}
+{
+}
+
+std::string_view Map_view::version() const
+{
+    return load_string(sections_.strings, record_ + map::version);
+}
+
+Map::Orientation Map_view::orientation() const
+{
+    const auto staggered{[this] {
+        return Map::Staggered{
+            to_enum(
+                load<u8>(record_ + map::stagger_axis),
+                Map::Staggered::Axis::y),
+            to_enum(
+                load<u8>(record_ + map::stagger_index),
+                Map::Staggered::Index::odd)};
+    }};
+
+    switch (load<u8>(record_ + map::orientation)) {
+    case 0: return Map::Orthogonal{};
+    case 1: return Map::Isometric{};
+    case 2: return staggered();
+    case 3:
+        return Map::Hexagonal{
+            staggered(), impl::load_pixels(record_, map::side_length)};
+    default: throw_invalid("orientation out of range");
+    }
+}
+
+Map::Render_order Map_view::render_order() const
+{
+    return to_enum(
+        load<u8>(record_ + map::render_order), Map::Render_order::left_up);
+}
+
+iSize Map_view::size() const
+{
+    return impl::load_isize(record_, map::width, map::height);
+}
+
+pxSize Map_view::general_tile_size() const
+{
+    return impl::load_pxsize(record_, map::tile_width, map::tile_height);
+}
+
+std::optional<Color> Map_view::background() const
+{
+    if (load<u8>(record_ + map::flags) & map::has_background)
+        return impl::load_color(record_, map::background);
+    return {};
+}
+
+Unique_id Map_view::next_id() const
+{
+    return Unique_id{Non_negative<int>{load<i32>(record_ + map::next_id)}};
+}
+
+Properties_view Map_view::properties() const
+{
+    return impl::load_properties(sections_, record_, map::properties);
+}
+
+auto Map_view::tile_sets() const -> Tile_sets
+{
+    return impl::Binary_view_access::array<Tile_set>(
+        sections_, record_, map::tile_sets, tile_set::size);
+}
+
+auto Map_view::layers() const -> Layers
+{
+    return impl::Binary_view_access::array<Layer>(
+        sections_, record_, map::layers, layer::size);
+}
+
+// Map_file --------------------------------------------------------------------
+
+namespace {
+
+std::unique_ptr<impl::Mapped_file> map_file(
+    const std::experimental::filesystem::path& path)
+{
+    const auto name{path.string()};
+
+    return std::make_unique<impl::Mapped_file>(
+        name.c_str(), impl::Mapped_file::Access::random);
+}
+
+} // namespace
+
+Map_file::Map_file(const std::experimental::filesystem::path& path)
+  : mapping_{map_file(path)}, view_{{mapping_->data(), mapping_->size()}}
+{
+}
+
+Map_file::Map_file(Map_file&&) noexcept = default;
+Map_file& Map_file::operator=(Map_file&&) noexcept = default;
+
+Map_file::~Map_file() = default;
+
+} // namespace tmxpp
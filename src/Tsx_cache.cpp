@@ -0,0 +1,150 @@
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <tmxpp/Tsx_cache.hpp>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Model_resource.hpp>
+
+namespace tmxpp {
+
+namespace fs = std::experimental::filesystem;
+
+namespace {
+
+// Returns: `tile_set` with the given `first_id` and `tsx`.
+Map::Tile_set rebased(
+    const Map::Tile_set& tile_set, Global_tile_id first_id, File tsx)
+{
+    auto rebased{tile_set};
+
+    std::visit(
+        [&](auto& ts) {
+            ts.first_id = first_id;
+            ts.tsx      = std::move(tsx);
+        },
+        rebased);
+
+    return rebased;
+}
+
+} // namespace
+
+Tsx_cache::Tsx_cache(std::size_t capacity) : capacity_{capacity}
+{
+}
+
+Map::Tile_set Tsx_cache::read_tsx(
+    Global_tile_id first_id, File tsx, const fs::path& base)
+{
+    Entry entry;
+
+    try {
+        const auto path{fs::canonical(tsx, base)};
+
+        entry.path            = path.string();
+        entry.last_write_time = fs::last_write_time(path);
+        entry.file_size       = fs::file_size(path);
+    }
+    catch (const fs::filesystem_error& e) {
+        throw Exception{e.what()};
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock{mutex_};
+
+        if (auto it{index_.find(entry.path)}; it != index_.end()) {
+            const auto& cached{*it->second};
+
+            if (cached.last_write_time == entry.last_write_time &&
+                cached.file_size == entry.file_size) {
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return rebased(*cached.tile_set, first_id, std::move(tsx));
+            }
+
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+    }
+
+    // Read without holding the lock, so that distinct TSXs load concurrently.
+    // The cached tile set outlives the memory resource of the reading thread.
+    {
+        const impl::Model_resource::Use use{nullptr};
+
+        entry.tile_set = std::make_shared<const Map::Tile_set>(
+            tmxpp::read_tsx(first_id, tsx, base));
+    }
+
+    auto tile_set{entry.tile_set};
+
+    const std::lock_guard<std::mutex> lock{mutex_};
+
+    if (auto it{index_.find(entry.path)}; it != index_.end()) {
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+
+    if (capacity_ != 0) {
+        entries_.push_front(std::move(entry));
+
+        try {
+            index_.emplace(entries_.front().path, entries_.begin());
+        }
+        catch (...) {
+            entries_.pop_front();
+            throw;
+        }
+
+        if (entries_.size() > capacity_) {
+            index_.erase(entries_.back().path);
+            entries_.pop_back();
+        }
+    }
+
+    return rebased(*tile_set, first_id, std::move(tsx));
+}
+
+Tsx_resolver Tsx_cache::resolver(const fs::path& base)
+{
+    return [this, base](Global_tile_id first_id, File tsx) {
+        return read_tsx(first_id, std::move(tsx), base);
+    };
+}
+
+void Tsx_cache::invalidate(const File& tsx, const fs::path& base)
+{
+    std::error_code error;
+    auto path{fs::canonical(tsx, base, error)};
+
+    if (error)
+        path = fs::absolute(tsx, base);
+
+    const std::lock_guard<std::mutex> lock{mutex_};
+
+    if (auto it{index_.find(path.string())}; it != index_.end()) {
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+}
+
+void Tsx_cache::clear() noexcept
+{
+    const std::lock_guard<std::mutex> lock{mutex_};
+
+    index_.clear();
+    entries_.clear();
+}
+
+std::size_t Tsx_cache::size() const
+{
+    const std::lock_guard<std::mutex> lock{mutex_};
+
+    return entries_.size();
+}
+
+std::size_t Tsx_cache::capacity() const noexcept
+{
+    return capacity_;
+}
+
+} // namespace tmxpp
@@ -0,0 +1,920 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <boost/hana/functional/overload.hpp>
+#include <tmxpp.hpp>
+#include <tmxpp/binary.hpp>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Mapped_file.hpp>
+#include <tmxpp/impl/Model_resource.hpp>
+#include <tmxpp/impl/Output_file.hpp>
+#include <tmxpp/impl/binary_format.hpp>
+#include <tmxpp/impl/little_endian.hpp>
+
+namespace tmxpp {
+
+namespace impl {
+namespace {
+
+using namespace binary;
+
+using u8  = std::uint_least8_t;
+using u32 = std::uint_least32_t;
+using i32 = std::int_least32_t;
+using u64 = std::uint_least64_t;
+
+using Raw_id = Data::Flipped_ids::raw_type;
+
+// Writing ---------------------------------------------------------------------
+
+// Returns: `x` as a `u32`.
+// Throws: `Exception` if `x` does not fit in a `u32`.
+u32 to_u32(std::size_t x)
+{
+    if (x > std::numeric_limits<u32>::max())
+        throw Exception{"Map too large for the binary format."};
+
+    return static_cast<u32>(x);
+}
+
+// Builds the sections of a binary TMX.
+class Binary_writer {
+public:
+    // Effects: Writes `map` as the root record.
+    explicit Binary_writer(const Map& map) : records_(map::size, '\0')
+    {
+        write(map, 0);
+    }
+
+    // Effects: Passes the binary TMX to `sink`.
+    void finish(const Sink& sink) const;
+
+private:
+    // Returns: The offset of `count` new zeroed records of `size` bytes.
+    std::size_t allocate(std::size_t count, std::size_t size)
+    {
+        const auto offset{records_.size()};
+        records_.resize(offset + count * size);
+        return offset;
+    }
+
+    template <class T>
+    void store(std::size_t at, T x) noexcept
+    {
+        binary::store(records_.data() + at, x);
+    }
+
+    void store_string(std::size_t at, std::string_view s);
+    void store_color(std::size_t at, Color c) noexcept;
+    void store_pixels(std::size_t at, Pixels px) noexcept
+    {
+        store(at, get(px));
+    }
+
+    // Effects: Stores an array at `at` of the elements of `rng`, each written
+    //          by `write(element, offset)` to a record of `size` bytes.
+    template <class Rng, class Write>
+    void store_array(
+        std::size_t at, const Rng& rng, std::size_t size, Write write)
+    {
+        const auto count{std::size(rng)};
+        auto offset{count == 0 ? 0 : allocate(count, size)};
+
+        store(at, to_u32(offset));
+        store(at + 4, to_u32(count));
+
+        for (const auto& x : rng) {
+            write(x, offset);
+            offset += size;
+        }
+    }
+
+    void store_properties(std::size_t at, const Properties& ps);
+
+    void write(const Property& p, std::size_t at);
+    void write(const Image& img, std::size_t at);
+    void write(const Animation& a, std::size_t at);
+    void write(const Object& obj, std::size_t at);
+    void write(const Layer& l, std::size_t at);
+    void write(const Tile_layer& l, std::size_t at);
+    void write(const Object_layer& l, std::size_t at);
+    void write(const Image_layer& l, std::size_t at);
+    void write(const std::optional<Object_layer>& shape, std::size_t at);
+    void write(const Tile_set::Tile& tile, std::size_t at);
+    void write(const Image_collection::Tile& tile, std::size_t at);
+    void write(const Tile_set& ts, std::size_t at);
+    void write(const Image_collection& ts, std::size_t at);
+    void write(const Map& map, std::size_t at);
+
+    std::string strings_;
+    std::unordered_map<std::string, u32> string_offsets_;
+    std::string records_;
+    std::vector<Raw_id> tile_ids_;
+};
+
+// Effects: Passes the section `tag` with the given `payload` to `sink`.
+void write_section(
+    const Sink& sink, const char (&tag)[4], std::string_view payload)
+{
+    char header[section_header_size]{};
+    std::memcpy(header, tag, sizeof(tag));
+    binary::store(header + 8, u64{payload.size()});
+
+    sink({header, sizeof(header)});
+
+    if (!payload.empty())
+        sink(payload);
+
+    constexpr char padding[alignment]{};
+
+    if (auto rest{payload.size() % alignment})
+        sink({padding, alignment - rest});
+}
+
+void Binary_writer::finish(const Sink& sink) const
+{
+    char header[header_size]{};
+    std::memcpy(header, magic, sizeof(magic));
+    binary::store(header + 4, version);
+    binary::store(header + 8, u32{3});
+
+    sink({header, sizeof(header)});
+
+    write_section(sink, strings_tag, strings_);
+    write_section(sink, records_tag, records_);
+    write_section(
+        sink, tile_ids_tag,
+        {reinterpret_cast<const char*>(tile_ids_.data()),
+         tile_ids_.size() * sizeof(Raw_id)});
+}
+
+void Binary_writer::store_string(std::size_t at, std::string_view s)
+{
+    auto [it, inserted]{
+        string_offsets_.try_emplace(std::string{s}, to_u32(strings_.size()))};
+
+    if (inserted)
+        strings_.append(s);
+
+    store(at, it->second);
+    store(at + 4, to_u32(s.size()));
+}
+
+void Binary_writer::store_color(std::size_t at, Color c) noexcept
+{
+    store(at, u8{c.a});
+    store(at + 1, u8{c.r});
+    store(at + 2, u8{c.g});
+    store(at + 3, u8{c.b});
+}
+
+void Binary_writer::store_properties(std::size_t at, const Properties& ps)
+{
+    store_array(
+        at, ps, property::size,
+        [this](const Property& p, std::size_t at) { write(p, at); });
+}
+
+void Binary_writer::write(const Property& p, std::size_t at)
+{
+    const auto value{at + property::value};
+
+    store_string(at + property::name, *p.name);
+    store(at + property::kind, static_cast<u8>(p.value.index()));
+
+    std::visit(
+        boost::hana::overload(
+            [&](const std::pmr::string& s) { store_string(value, s); },
+            [&](int i) { store(value, i32{i}); },
+            [&](double d) { store(value, d); },
+            [&](bool b) { store(value, u8{b}); },
+            [&](Color c) { store_color(value, c); },
+            [&](const File& f) { store_string(value, f.string()); }),
+        p.value);
+}
+
+void Binary_writer::write(const Image& img, std::size_t at)
+{
+    u8 flags{};
+
+    store_string(at + image::source, img.source.string());
+
+    if (img.transparent) {
+        flags |= image::has_transparent;
+        store_color(at + image::transparent, *img.transparent);
+    }
+
+    if (img.size) {
+        flags |= image::has_size;
+        store_pixels(at + image::width, *img.size->w);
+        store_pixels(at + image::height, *img.size->h);
+    }
+
+    store(at + image::flags, flags);
+}
+
+void Binary_writer::write(const Animation& a, std::size_t at)
+{
+    store_array(at, a, frame::size, [this](const Frame& f, std::size_t at) {
+        store(at + frame::id, i32{*f.id});
+        store(at + frame::duration, i32{f.duration->count()});
+    });
+}
+
+void Binary_writer::write(const Object& obj, std::size_t at)
+{
+    store_string(at + object::name, obj.name);
+    store_string(at + object::type, obj.type);
+    store_pixels(at + object::x, obj.position.x);
+    store_pixels(at + object::y, obj.position.y);
+    store(at + object::clockwise_rotation, get(obj.clockwise_rotation));
+
+    if (obj.shape) {
+        store(at + object::shape, static_cast<u8>(obj.shape->index() + 1));
+
+        std::visit(
+            [&](const auto& shape) {
+                using Shape = std::decay_t<decltype(shape)>;
+
+                if constexpr (
+                    std::is_same_v<Shape, Object::Rectangle> ||
+                    std::is_same_v<Shape, Object::Ellipse>) {
+                    store_pixels(at + object::width, *shape.size.w);
+                    store_pixels(at + object::height, *shape.size.h);
+                }
+                else
+                    store_array(
+                        at + object::points, shape.points, point::size,
+                        [this](Point pt, std::size_t at) {
+                            store_pixels(at + point::x, pt.x);
+                            store_pixels(at + point::y, pt.y);
+                        });
+            },
+            *obj.shape);
+    }
+
+    store_properties(at + object::properties, obj.properties);
+    store(at + object::unique_id, i32{*get(obj.unique_id)});
+    store(at + object::global_id, obj.global_id ? i32{**obj.global_id} : 0);
+    store(at + object::visible, u8{obj.visible});
+}
+
+void Binary_writer::write(const Layer& l, std::size_t at)
+{
+    store_string(at + layer::name, l.name);
+    store(at + layer::opacity, *l.opacity);
+    store_pixels(at + layer::offset_x, l.offset.x);
+    store_pixels(at + layer::offset_y, l.offset.y);
+    store_properties(at + layer::properties, l.properties);
+    store(at + layer::visible, u8{l.visible});
+}
+
+void Binary_writer::write(const Tile_layer& l, std::size_t at)
+{
+    write(static_cast<const Layer&>(l), at);
+
+    const auto& raw_ids{l.data.ids.raw()};
+
+    store(at + layer::kind, u8{0});
+    store(at + layer::width, i32{*l.size.w});
+    store(at + layer::height, i32{*l.size.h});
+    store(at + layer::tile_ids, to_u32(tile_ids_.size()));
+    store(at + layer::tile_ids + 4, to_u32(raw_ids.size()));
+    store(at + layer::encoding, static_cast<u8>(l.data.format.encoding()));
+    store(
+        at + layer::compression,
+        static_cast<u8>(l.data.format.compression()));
+
+    tile_ids_.reserve(tile_ids_.size() + raw_ids.size());
+    std::transform(
+        raw_ids.begin(), raw_ids.end(), std::back_inserter(tile_ids_),
+        [](Raw_id id) { return little_endian(id); });
+}
+
+void Binary_writer::write(const Object_layer& l, std::size_t at)
+{
+    write(static_cast<const Layer&>(l), at);
+
+    store(at + layer::kind, u8{1});
+
+    if (l.color) {
+        store(at + layer::object_flags, layer::has_color);
+        store_color(at + layer::color, *l.color);
+    }
+
+    store(at + layer::draw_order, static_cast<u8>(l.draw_order));
+    store_array(
+        at + layer::objects, l.objects, object::size,
+        [this](const Object& obj, std::size_t at) { write(obj, at); });
+}
+
+void Binary_writer::write(const Image_layer& l, std::size_t at)
+{
+    write(static_cast<const Layer&>(l), at);
+
+    store(at + layer::kind, u8{2});
+
+    if (l.image) {
+        store(at + layer::image_flags, layer::has_image);
+        write(*l.image, at + layer::image);
+    }
+}
+
+void Binary_writer::write(
+    const std::optional<Object_layer>& shape, std::size_t at)
+{
+    if (!shape)
+        return;
+
+    const auto offset{allocate(1, layer::size)};
+
+    store(at, to_u32(offset));
+    store(at + 4, u32{1});
+    write(*shape, offset);
+}
+
+void Binary_writer::write(const Tile_set::Tile& t, std::size_t at)
+{
+    store(at + tile::id, i32{*t.id});
+    store_properties(at + tile::properties, t.properties);
+    write(t.animation, at + tile::animation);
+    write(t.collision_shape, at + tile::collision_shape);
+}
+
+void Binary_writer::write(const Image_collection::Tile& t, std::size_t at)
+{
+    store(at + tile::id, i32{*t.id});
+    store_properties(at + tile::properties, t.properties);
+    write(t.animation, at + tile::animation);
+    write(t.collision_shape, at + tile::collision_shape);
+    write(t.image, at + tile::image);
+}
+
+void Binary_writer::write(const Tile_set& ts, std::size_t at)
+{
+    store(at + tile_set::kind, u8{0});
+    store_string(at + tile_set::tsx, ts.tsx.string());
+    store_string(at + tile_set::name, ts.name);
+    store_pixels(at + tile_set::tile_width, *ts.tile_size.w);
+    store_pixels(at + tile_set::tile_height, *ts.tile_size.h);
+    store_pixels(at + tile_set::spacing, *ts.spacing);
+    store_pixels(at + tile_set::margin, *ts.margin);
+    store_pixels(at + tile_set::tile_offset_x, ts.tile_offset.x);
+    store_pixels(at + tile_set::tile_offset_y, ts.tile_offset.y);
+    store_properties(at + tile_set::properties, ts.properties);
+    write(ts.image, at + tile_set::image);
+    store(at + tile_set::first_id, i32{*ts.first_id});
+    store(at + tile_set::columns, i32{*ts.size.w});
+    store(at + tile_set::rows, i32{*ts.size.h});
+    store_array(
+        at + tile_set::tiles, ts.tiles, tile::size,
+        [this](const Tile_set::Tile& t, std::size_t at) { write(t, at); });
+}
+
+void Binary_writer::write(const Image_collection& ts, std::size_t at)
+{
+    store(at + tile_set::kind, u8{1});
+    store_string(at + tile_set::tsx, ts.tsx.string());
+    store_string(at + tile_set::name, ts.name);
+    store_pixels(at + tile_set::tile_width, *ts.max_tile_size.w);
+    store_pixels(at + tile_set::tile_height, *ts.max_tile_size.h);
+    store_pixels(at + tile_set::tile_offset_x, ts.tile_offset.x);
+    store_pixels(at + tile_set::tile_offset_y, ts.tile_offset.y);
+    store_properties(at + tile_set::properties, ts.properties);
+    store(at + tile_set::first_id, i32{*ts.first_id});
+    store(at + tile_set::columns, i32{*ts.columns});
+    store(at + tile_set::tile_count, i32{*ts.tile_count});
+    store_array(
+        at + tile_set::tiles, ts.tiles, tile::size,
+        [this](const Image_collection::Tile& t, std::size_t at) {
+            write(t, at);
+        });
+}
+
+void Binary_writer::write(const Map& m, std::size_t at)
+{
+    store_string(at + map::version, m.version);
+    store(at + map::orientation, static_cast<u8>(m.orientation.index()));
+
+    if (auto staggered{std::get_if<Map::Staggered>(&m.orientation)}) {
+        store(at + map::stagger_axis, static_cast<u8>(staggered->axis));
+        store(at + map::stagger_index, static_cast<u8>(staggered->index));
+    }
+    else if (auto hexagonal{std::get_if<Map::Hexagonal>(&m.orientation)}) {
+        store(at + map::stagger_axis, static_cast<u8>(hexagonal->axis));
+        store(at + map::stagger_index, static_cast<u8>(hexagonal->index));
+        store_pixels(at + map::side_length, hexagonal->side_length);
+    }
+
+    store(at + map::render_order, static_cast<u8>(m.render_order));
+    store(at + map::width, i32{*m.size.w});
+    store(at + map::height, i32{*m.size.h});
+    store_pixels(at + map::tile_width, *m.general_tile_size.w);
+    store_pixels(at + map::tile_height, *m.general_tile_size.h);
+
+    if (m.background) {
+        store(at + map::flags, map::has_background);
+        store_color(at + map::background, *m.background);
+    }
+
+    store(at + map::next_id, i32{*get(m.next_id)});
+    store_properties(at + map::properties, m.properties);
+    store_array(
+        at + map::tile_sets, m.tile_sets, tile_set::size,
+        [this](const Map::Tile_set& ts, std::size_t at) {
+            std::visit([&](const auto& ts) { write(ts, at); }, ts);
+        });
+    store_array(
+        at + map::layers, m.layers, layer::size,
+        [this](const Map::Layer& l, std::size_t at) {
+            std::visit([&](const auto& l) { write(l, at); }, l);
+        });
+}
+
+// Reading ---------------------------------------------------------------------
+
+// Reads the `Map` of a binary TMX.
+// The model is allocated from `Model_resource::get()`.
+class Binary_reader {
+public:
+    // Effects: Finds the sections of the binary TMX `binary`.
+    // Throws: `Exception` if `binary` is not a binary TMX of the supported
+    //         version.
+    explicit Binary_reader(std::string_view binary)
+      : sections_{find_sections(binary)}
+    {
+    }
+
+    Map read_map() const
+    {
+        return read_map(records(0, 1, map::size));
+    }
+
+private:
+    const char* records(u32 offset, std::size_t count, std::size_t size) const
+    {
+        return load_records(sections_.records, offset, count, size);
+    }
+
+    template <class T>
+    static T load(const char* record, std::size_t field) noexcept
+    {
+        return binary::load<T>(record + field);
+    }
+
+    static Pixels load_pixels(const char* record, std::size_t field) noexcept
+    {
+        return Pixels{load<double>(record, field)};
+    }
+
+    static bool load_bool(const char* record, std::size_t field) noexcept
+    {
+        return load<u8>(record, field) != 0;
+    }
+
+    static Color load_color(const char* record, std::size_t field) noexcept
+    {
+        return {load<u8>(record, field), load<u8>(record, field + 1),
+                load<u8>(record, field + 2), load<u8>(record, field + 3)};
+    }
+
+    static pxSize load_pxsize(
+        const char* record, std::size_t width, std::size_t height)
+    {
+        return {pxSize::Dimension{load_pixels(record, width)},
+                pxSize::Dimension{load_pixels(record, height)}};
+    }
+
+    static iSize load_isize(
+        const char* record, std::size_t width, std::size_t height)
+    {
+        return {iSize::Dimension{load<i32>(record, width)},
+                iSize::Dimension{load<i32>(record, height)}};
+    }
+
+    static Offset load_offset(
+        const char* record, std::size_t x, std::size_t y) noexcept
+    {
+        return {load_pixels(record, x), load_pixels(record, y)};
+    }
+
+    std::string_view load_string_view(
+        const char* record, std::size_t field) const
+    {
+        return binary::load_string(sections_.strings, record + field);
+    }
+
+    std::pmr::string load_string(const char* record, std::size_t field) const
+    {
+        return std::pmr::string{
+            load_string_view(record, field), Model_resource::get()};
+    }
+
+    File load_file(const char* record, std::size_t field) const
+    {
+        const auto s{load_string_view(record, field)};
+
+        return File{s.begin(), s.end()};
+    }
+
+    // Returns: A `Cont` of the elements read by `read(record)` from the
+    //          records of `size` bytes of the array at `field`.
+    template <class Cont, class Read>
+    Cont load_array(
+        const char* record, std::size_t field, std::size_t size,
+        Read read) const
+    {
+        const auto count{load<u32>(record, field + 4)};
+        auto first{records(load<u32>(record, field), count, size)};
+
+        Cont cont{Model_resource::get()};
+        cont.reserve(count);
+
+        for (u32 i{0}; i != count; ++i, first += size)
+            cont.push_back(read(first));
+
+        return cont;
+    }
+
+    Properties load_properties(const char* record, std::size_t field) const
+    {
+        return load_array<Properties>(
+            record, field, property::size,
+            [this](const char* r) { return read_property(r); });
+    }
+
+    Property read_property(const char* r) const;
+    Image read_image(const char* r) const;
+    Animation read_animation(const char* r, std::size_t field) const;
+    Object read_object(const char* r) const;
+    Layer read_layer_base(const char* r) const;
+    Tile_layer read_tile_layer(const char* r) const;
+    Object_layer read_object_layer(const char* r) const;
+    Image_layer read_image_layer(const char* r) const;
+    std::optional<Object_layer> read_collision_shape(const char* r) const;
+    Tile_set::Tile read_tile_set_tile(const char* r) const;
+    Image_collection::Tile read_image_collection_tile(const char* r) const;
+    Map::Tile_set read_tile_set(const char* r) const;
+    Map::Layer read_layer(const char* r) const;
+    Map::Orientation read_orientation(const char* r) const;
+    Map read_map(const char* r) const;
+
+    Binary_sections sections_;
+};
+
+Property Binary_reader::read_property(const char* r) const
+{
+    const auto value{property::value};
+
+    return {Non_empty<std::pmr::string>{load_string(r, property::name)},
+            [&]() -> Property::Value {
+                switch (load<u8>(r, property::kind)) {
+                case 0: return load_string(r, value);
+                case 1: return int{load<i32>(r, value)};
+                case 2: return load<double>(r, value);
+                case 3: return load_bool(r, value);
+                case 4: return load_color(r, value);
+                case 5: return load_file(r, value);
+                default: throw_invalid("property kind out of range");
+                }
+            }()};
+}
+
+Image Binary_reader::read_image(const char* r) const
+{
+    const auto flags{load<u8>(r, image::flags)};
+
+    Image img{load_file(r, image::source), {}, {}};
+
+    if (flags & image::has_transparent)
+        img.transparent = load_color(r, image::transparent);
+    if (flags & image::has_size)
+        img.size = load_pxsize(r, image::width, image::height);
+
+    return img;
+}
+
+Animation Binary_reader::read_animation(
+    const char* r, std::size_t field) const
+{
+    return load_array<Animation>(r, field, frame::size, [](const char* r) {
+        return Frame{Local_tile_id{load<i32>(r, frame::id)},
+                     Non_negative<Frame::Duration>{
+                         Frame::Duration{load<i32>(r, frame::duration)}}};
+    });
+}
+
+Object Binary_reader::read_object(const char* r) const
+{
+    const auto read_points{[&] {
+        return load_array<Object::Polygon::Points>(
+            r, object::points, point::size, [](const char* r) {
+                return Point{load_pixels(r, point::x),
+                             load_pixels(r, point::y)};
+            });
+    }};
+
+    const auto shape{[&]() -> std::optional<Object::Shape> {
+        switch (load<u8>(r, object::shape)) {
+        case 0: return {};
+        case 1:
+            return Object::Rectangle{
+                load_pxsize(r, object::width, object::height)};
+        case 2:
+            return Object::Ellipse{
+                load_pxsize(r, object::width, object::height)};
+        case 3: return Object::Polygon{read_points()};
+        case 4: return Object::Polyline{read_points()};
+        default: throw_invalid("object shape out of range");
+        }
+    }};
+
+    const auto global_id{[&]() -> std::optional<Global_tile_id> {
+        if (auto id{load<i32>(r, object::global_id)})
+            return Global_tile_id{id};
+        return {};
+    }};
+
+    return {Unique_id{Non_negative<int>{load<i32>(r, object::unique_id)}},
+            load_string(r, object::name),
+            load_string(r, object::type),
+            Point{load_pixels(r, object::x), load_pixels(r, object::y)},
+            shape(),
+            Degrees{load<double>(r, object::clockwise_rotation)},
+            global_id(),
+            load_bool(r, object::visible),
+            load_properties(r, object::properties)};
+}
+
+Layer Binary_reader::read_layer_base(const char* r) const
+{
+    return {load_string(r, layer::name),
+            Unit_interval{load<double>(r, layer::opacity)},
+            load_bool(r, layer::visible),
+            load_offset(r, layer::offset_x, layer::offset_y),
+            load_properties(r, layer::properties)};
+}
+
+Tile_layer Binary_reader::read_tile_layer(const char* r) const
+{
+    const auto bytes{load_tile_ids(sections_.tile_ids, r)};
+
+    std::vector<Raw_id> raw_ids(bytes.size() / sizeof(Raw_id));
+    if (!bytes.empty())
+        std::memcpy(raw_ids.data(), bytes.data(), bytes.size());
+
+    for (auto& id : raw_ids)
+        id = little_endian(id);
+
+    return {read_layer_base(r),
+            load_isize(r, layer::width, layer::height),
+            Data{Data::Format{to_enum(
+                                  load<u8>(r, layer::encoding),
+                                  Data::Encoding::base64),
+                              to_enum(
+                                  load<u8>(r, layer::compression),
+                                  Data::Compression::zstd)},
+                 Data::Flipped_ids{std::move(raw_ids)}}};
+}
+
+Object_layer Binary_reader::read_object_layer(const char* r) const
+{
+    std::optional<Color> color;
+
+    if (load<u8>(r, layer::object_flags) & layer::has_color)
+        color = load_color(r, layer::color);
+
+    return {read_layer_base(r), color,
+            to_enum(
+                load<u8>(r, layer::draw_order),
+                Object_layer::Draw_order::index),
+            load_array<Object_layer::Objects>(
+                r, layer::objects, object::size,
+                [this](const char* r) { return read_object(r); })};
+}
+
+Image_layer Binary_reader::read_image_layer(const char* r) const
+{
+    std::optional<Image> img;
+
+    if (load<u8>(r, layer::image_flags) & layer::has_image)
+        img = read_image(r + layer::image);
+
+    return {read_layer_base(r), std::move(img)};
+}
+
+std::optional<Object_layer> Binary_reader::read_collision_shape(
+    const char* r) const
+{
+    const auto count{load<u32>(r, tile::collision_shape + 4)};
+
+    if (count == 0)
+        return {};
+    if (count != 1)
+        throw_invalid("more than one collision shape");
+
+    auto shape{records(load<u32>(r, tile::collision_shape), 1, layer::size)};
+
+    if (load<u8>(shape, layer::kind) != 1)
+        throw_invalid("collision shape is not an object layer");
+
+    return read_object_layer(shape);
+}
+
+Tile_set::Tile Binary_reader::read_tile_set_tile(const char* r) const
+{
+    return {Local_tile_id{load<i32>(r, tile::id)},
+            load_properties(r, tile::properties),
+            read_collision_shape(r), read_animation(r, tile::animation)};
+}
+
+Image_collection::Tile Binary_reader::read_image_collection_tile(
+    const char* r) const
+{
+    return {Local_tile_id{load<i32>(r, tile::id)},
+            load_properties(r, tile::properties), read_image(r + tile::image),
+            read_collision_shape(r), read_animation(r, tile::animation)};
+}
+
+Map::Tile_set Binary_reader::read_tile_set(const char* r) const
+{
+    const auto first_id{Global_tile_id{load<i32>(r, tile_set::first_id)}};
+    const auto tile_offset{
+        load_offset(r, tile_set::tile_offset_x, tile_set::tile_offset_y)};
+
+    switch (load<u8>(r, tile_set::kind)) {
+    case 0:
+        return Tile_set{
+            first_id,
+            load_file(r, tile_set::tsx),
+            load_string(r, tile_set::name),
+            load_pxsize(r, tile_set::tile_width, tile_set::tile_height),
+            Non_negative<Pixels>{load_pixels(r, tile_set::spacing)},
+            Non_negative<Pixels>{load_pixels(r, tile_set::margin)},
+            load_isize(r, tile_set::columns, tile_set::rows),
+            tile_offset,
+            load_properties(r, tile_set::properties),
+            read_image(r + tile_set::image),
+            load_array<Tile_set::Tiles>(
+                r, tile_set::tiles, tile::size,
+                [this](const char* r) { return read_tile_set_tile(r); })};
+    case 1:
+        return Image_collection{
+            first_id,
+            load_file(r, tile_set::tsx),
+            load_string(r, tile_set::name),
+            load_pxsize(r, tile_set::tile_width, tile_set::tile_height),
+            Non_negative<int>{load<i32>(r, tile_set::tile_count)},
+            Non_negative<int>{load<i32>(r, tile_set::columns)},
+            tile_offset,
+            load_properties(r, tile_set::properties),
+            load_array<Image_collection::Tiles>(
+                r, tile_set::tiles, tile::size, [this](const char* r) {
+                    return read_image_collection_tile(r);
+                })};
+    default: throw_invalid("tile set kind out of range");
+    }
+}
+
+Map::Layer Binary_reader::read_layer(const char* r) const
+{
+    switch (load<u8>(r, layer::kind)) {
+    case 0: return read_tile_layer(r);
+    case 1: return read_object_layer(r);
+    case 2: return read_image_layer(r);
+    default: throw_invalid("layer kind out of range");
+    }
+}
+
+Map::Orientation Binary_reader::read_orientation(const char* r) const
+{
+    const auto staggered{[r] {
+        return Map::Staggered{
+            to_enum(load<u8>(r, map::stagger_axis), Map::Staggered::Axis::y),
+            to_enum(
+                load<u8>(r, map::stagger_index), Map::Staggered::Index::odd)};
+    }};
+
+    switch (load<u8>(r, map::orientation)) {
+    case 0: return Map::Orthogonal{};
+    case 1: return Map::Isometric{};
+    case 2: return staggered();
+    case 3:
+        return Map::Hexagonal{staggered(), load_pixels(r, map::side_length)};
+    default: throw_invalid("orientation out of range");
+    }
+}
+
+Map Binary_reader::read_map(const char* r) const
+{
+    std::optional<Color> background;
+
+    if (load<u8>(r, map::flags) & map::has_background)
+        background = load_color(r, map::background);
+
+    return {load_string(r, map::version),
+            read_orientation(r),
+            to_enum(
+                load<u8>(r, map::render_order), Map::Render_order::left_up),
+            load_isize(r, map::width, map::height),
+            load_pxsize(r, map::tile_width, map::tile_height),
+            background,
+            Unique_id{Non_negative<int>{load<i32>(r, map::next_id)}},
+            load_properties(r, map::properties),
+            load_array<Map::Tile_sets>(
+                r, map::tile_sets, tile_set::size,
+                [this](const char* r) { return read_tile_set(r); }),
+            load_array<Map::Layers>(
+                r, map::layers, layer::size,
+                [this](const char* r) { return read_layer(r); })};
+}
+
+// Returns: The contents of the file `path`.
+// Throws: `Exception` if it could not be read.
+std::string read_file(const std::experimental::filesystem::path& path)
+{
+    std::ifstream ifs{path, std::ios::binary};
+    std::string contents{std::istreambuf_iterator<char>{ifs}, {}};
+
+    if (ifs.bad() || !ifs.is_open())
+        throw Exception{"Input path " + path.string() + " presented problems."};
+
+    return contents;
+}
+
+Map read_binary(std::string_view binary, const Read_options& options)
+{
+    const Model_resource::Use use{options.memory_resource};
+
+    return Binary_reader{binary}.read_map();
+}
+
+} // namespace
+} // namespace impl
+
+void write_binary(
+    const Map& map, const std::experimental::filesystem::path& path)
+{
+    // The binary is laid out before creating the file, so that an error in
+    // `map` does not even leave a temporary file.
+    const impl::Binary_writer writer{map};
+
+    impl::Output_file binary{path};
+
+    writer.finish(binary.sink());
+    binary.finish();
+}
+
+void write_binary(const Map& map, const Sink& sink)
+{
+    impl::Binary_writer{map}.finish(sink);
+}
+
+std::string to_binary(const Map& map)
+{
+    std::string binary;
+
+    write_binary(map, [&](std::string_view chunk) { binary.append(chunk); });
+
+    return binary;
+}
+
+Map read_binary(
+    const std::experimental::filesystem::path& path,
+    const Read_options& options) try {
+    const auto name{path.string()};
+    std::optional<impl::Mapped_file> mapping;
+
+    try {
+        mapping.emplace(name.c_str());
+    }
+    catch (const Exception&) {
+        return impl::read_binary(impl::read_file(path), options);
+    }
+
+    return impl::read_binary({mapping->data(), mapping->size()}, options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+Map read_binary(Document binary, const Read_options& options) try {
+    return impl::read_binary(get(binary), options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+} // namespace tmxpp
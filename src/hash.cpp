@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <boost/hana/functional/overload.hpp>
+#include <tmxpp/hash.hpp>
+#include <tmxpp/impl/little_endian.hpp>
+
+namespace tmxpp {
+
+namespace impl {
+namespace {
+
+using u32 = std::uint_least32_t;
+using u64 = std::uint_least64_t;
+
+using Raw_id = Data::Flipped_ids::raw_type;
+
+// wyhash --------------------------------------------------------------------
+
+constexpr u64 secret[4]{0x2d358dccaa6c78a5, 0x8bb84b93962eacc9,
+                        0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47};
+
+// Effects: Replaces `a` and `b` with the low and high halves of `a * b`.
+void multiply(u64& a, u64& b) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    const auto product{static_cast<unsigned __int128>(a) * b};
+    a = static_cast<u64>(product);
+    b = static_cast<u64>(product >> 64);
+#else
+    const u64 ha{a >> 32}, hb{b >> 32}, la{a & 0xffffffff}, lb{b & 0xffffffff};
+    const u64 rh{ha * hb}, rm0{ha * lb}, rm1{hb * la}, rl{la * lb};
+    const u64 t{rl + (rm0 << 32)};
+    const u64 lo{t + (rm1 << 32)};
+    const u64 hi{rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t)};
+    a = lo;
+    b = hi;
+#endif
+}
+
+u64 mix(u64 a, u64 b) noexcept
+{
+    multiply(a, b);
+    return a ^ b;
+}
+
+u64 read8(const unsigned char* p) noexcept
+{
+    u64 x;
+    std::memcpy(&x, p, sizeof(x));
+    return little_endian(x);
+}
+
+u64 read4(const unsigned char* p) noexcept
+{
+    u32 x;
+    std::memcpy(&x, p, sizeof(x));
+    return little_endian(x);
+}
+
+// Computes the wyhash (final version 4) of the concatenation of the bytes
+// passed to `add`, without keeping them.
+// Long inputs are consumed in blocks of 48 bytes by three independent lanes.
+class Hasher {
+public:
+    static constexpr std::size_t block_size{48};
+
+    explicit Hasher(u64 seed = 0) noexcept
+      : seed_{seed ^ mix(seed ^ secret[0], secret[1])}
+    {
+    }
+
+    void add(const void* data, std::size_t size) noexcept;
+
+    u64 finish() const noexcept;
+
+private:
+    // The bytes of the last block, followed by the pending bytes.
+    static constexpr std::size_t history_size{16};
+
+    void consume(const unsigned char* block) noexcept
+    {
+        if (!has_blocks_) {
+            see1_ = see2_ = seed_;
+            has_blocks_ = true;
+        }
+
+        seed_ = mix(read8(block) ^ secret[1], read8(block + 8) ^ seed_);
+        see1_ = mix(read8(block + 16) ^ secret[2], read8(block + 24) ^ see1_);
+        see2_ = mix(read8(block + 32) ^ secret[3], read8(block + 40) ^ see2_);
+    }
+
+    u64 seed_;
+    u64 see1_{};
+    u64 see2_{};
+    bool has_blocks_{};
+    std::size_t size_{};
+    std::size_t pending_{};
+    unsigned char buffer_[history_size + block_size]{};
+};
+
+void Hasher::add(const void* data, std::size_t size) noexcept
+{
+    auto p{static_cast<const unsigned char*>(data)};
+    size_ += size;
+
+    // A block is consumed only once a byte after it is known, as the last
+    // bytes are hashed differently.
+    while (size != 0) {
+        if (pending_ == block_size) {
+            consume(buffer_ + history_size);
+            std::memcpy(buffer_, buffer_ + block_size, history_size);
+            pending_ = 0;
+        }
+
+        if (pending_ == 0 && size > block_size) {
+            for (; size > block_size; p += block_size, size -= block_size)
+                consume(p);
+
+            std::memcpy(buffer_, p - history_size, history_size);
+        }
+
+        const auto n{std::min(block_size - pending_, size)};
+        std::memcpy(buffer_ + history_size + pending_, p, n);
+        pending_ += n;
+        p += n;
+        size -= n;
+    }
+}
+
+u64 Hasher::finish() const noexcept
+{
+    const auto p{buffer_ + history_size};
+    auto seed{seed_};
+    u64 a{};
+    u64 b{};
+
+    if (size_ <= 16) {
+        if (size_ >= 4) {
+            const auto shift{(size_ >> 3) << 2};
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + size_ - 4) << 32) | read4(p + size_ - 4 - shift);
+        }
+        else if (size_ > 0) {
+            a = (u64{p[0]} << 16) | (u64{p[size_ >> 1]} << 8) | p[size_ - 1];
+        }
+    }
+    else {
+        if (has_blocks_)
+            seed ^= see1_ ^ see2_;
+
+        auto q{p};
+        auto i{pending_};
+
+        for (; i > 16; q += 16, i -= 16)
+            seed = mix(read8(q) ^ secret[1], read8(q + 8) ^ seed);
+
+        a = read8(q + i - 16);
+        b = read8(q + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    multiply(a, b);
+
+    return mix(a ^ secret[0] ^ size_, b ^ secret[1]);
+}
+
+// Encoding --------------------------------------------------------------------
+//
+// The model is hashed as a canonical sequence of bytes, independent of the
+// platform. Numbers are 8-byte little endian, with doubles as their IEEE 754
+// bits and zeros unsigned so that equal values hash equal. Strings, files and
+// ranges are preceded by their size, optionals by whether they have a value,
+// and variants by the index of their alternative.
+
+void add(Hasher& h, u64 x) noexcept
+{
+    x = little_endian(x);
+    h.add(&x, sizeof(x));
+}
+
+template <class T, class = std::enable_if_t<std::is_enum_v<T>>>
+void add(Hasher& h, T x) noexcept
+{
+    add(h, static_cast<u64>(x));
+}
+
+void add(Hasher& h, int x) noexcept
+{
+    add(h, static_cast<u64>(static_cast<std::int_least64_t>(x)));
+}
+
+void add(Hasher& h, bool x) noexcept
+{
+    add(h, u64{x});
+}
+
+void add(Hasher& h, double x) noexcept
+{
+    static_assert(sizeof(double) == sizeof(u64));
+
+    if (x == 0)
+        x = 0;
+
+    u64 bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    add(h, bits);
+}
+
+void add(Hasher& h, std::string_view s) noexcept
+{
+    add(h, u64{s.size()});
+    h.add(s.data(), s.size());
+}
+
+void add(Hasher& h, const File& f)
+{
+    add(h, std::string_view{f.generic_string()});
+}
+
+void add(Hasher& h, Pixels px) noexcept
+{
+    add(h, get(px));
+}
+
+void add(Hasher& h, Color c) noexcept
+{
+    add(h, (u64{c.a} << 24) | (u64{c.r} << 16) | (u64{c.g} << 8) | c.b);
+}
+
+template <class T>
+void add(Hasher& h, const std::optional<T>& x)
+{
+    add(h, x.has_value());
+
+    if (x)
+        add(h, *x);
+}
+
+template <class Rng>
+void add_range(Hasher& h, const Rng& rng)
+{
+    add(h, u64{std::size(rng)});
+
+    for (const auto& x : rng)
+        add(h, x);
+}
+
+void add(Hasher& h, pxSize s) noexcept
+{
+    add(h, *s.w);
+    add(h, *s.h);
+}
+
+void add(Hasher& h, iSize s) noexcept
+{
+    add(h, *s.w);
+    add(h, *s.h);
+}
+
+void add(Hasher& h, Offset o) noexcept
+{
+    add(h, o.x);
+    add(h, o.y);
+}
+
+void add(Hasher& h, const Property& p)
+{
+    add(h, std::string_view{*p.name});
+    add(h, u64{p.value.index()});
+    std::visit(
+        boost::hana::overload(
+            [&](const std::pmr::string& s) { add(h, std::string_view{s}); },
+            [&](const auto& x) { add(h, x); }),
+        p.value);
+}
+
+void add(Hasher& h, const Properties& ps)
+{
+    add_range(h, ps);
+}
+
+void add(Hasher& h, const Image& img)
+{
+    add(h, img.source);
+    add(h, img.transparent);
+    add(h, img.size);
+}
+
+void add(Hasher& h, Frame f) noexcept
+{
+    add(h, *f.id);
+    add(h, f.duration->count());
+}
+
+void add(Hasher& h, Point pt) noexcept
+{
+    add(h, pt.x);
+    add(h, pt.y);
+}
+
+void add(Hasher& h, const Object::Shape& shape)
+{
+    add(h, u64{shape.index()});
+    std::visit(
+        [&](const auto& shape) {
+            using Shape = std::decay_t<decltype(shape)>;
+
+            if constexpr (
+                std::is_same_v<Shape, Object::Rectangle> ||
+                std::is_same_v<Shape, Object::Ellipse>)
+                add(h, shape.size);
+            else
+                add_range(h, shape.points);
+        },
+        shape);
+}
+
+void add(Hasher& h, const Object& obj)
+{
+    add(h, *get(obj.unique_id));
+    add(h, std::string_view{obj.name});
+    add(h, std::string_view{obj.type});
+    add(h, obj.position);
+    add(h, obj.shape);
+    add(h, get(obj.clockwise_rotation));
+    add(h, obj.global_id ? std::optional<int>{**obj.global_id} : std::nullopt);
+    add(h, obj.visible);
+    add(h, obj.properties);
+}
+
+void add(Hasher& h, const Layer& l)
+{
+    add(h, std::string_view{l.name});
+    add(h, *l.opacity);
+    add(h, l.visible);
+    add(h, l.offset);
+    add(h, l.properties);
+}
+
+// Effects: Adds the raw tile ids as little endian `u32`s.
+void add(Hasher& h, const Data::Flipped_ids& ids)
+{
+    static_assert(sizeof(Raw_id) == 4);
+
+    const auto& raw{ids.raw()};
+    add(h, u64{raw.size()});
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    Raw_id chunk[256];
+
+    for (std::size_t i{0}; i < raw.size(); i += std::size(chunk)) {
+        const auto n{std::min(std::size(chunk), raw.size() - i)};
+
+        for (std::size_t j{0}; j != n; ++j)
+            chunk[j] = little_endian(raw[i + j]);
+
+        h.add(chunk, n * sizeof(Raw_id));
+    }
+#else
+    h.add(raw.data(), raw.size() * sizeof(Raw_id));
+#endif
+}
+
+void add(Hasher& h, const Tile_layer& l)
+{
+    add(h, u64{0});
+    add(h, static_cast<const Layer&>(l));
+    add(h, l.size);
+    add(h, l.data.format.encoding());
+    add(h, l.data.format.compression());
+    add(h, l.data.ids);
+}
+
+void add(Hasher& h, const Object_layer& l)
+{
+    add(h, u64{1});
+    add(h, static_cast<const Layer&>(l));
+    add(h, l.color);
+    add(h, l.draw_order);
+    add_range(h, l.objects);
+}
+
+void add(Hasher& h, const Image_layer& l)
+{
+    add(h, u64{2});
+    add(h, static_cast<const Layer&>(l));
+    add(h, l.image);
+}
+
+void add_tile(Hasher& h, const Tile_set::Tile& t)
+{
+    add(h, *t.id);
+    add(h, t.properties);
+    add(h, t.collision_shape);
+    add_range(h, t.animation);
+}
+
+void add_tile(Hasher& h, const Image_collection::Tile& t)
+{
+    add(h, *t.id);
+    add(h, t.properties);
+    add(h, t.image);
+    add(h, t.collision_shape);
+    add_range(h, t.animation);
+}
+
+void add(Hasher& h, const Tile_set& ts)
+{
+    add(h, u64{0});
+    add(h, *ts.first_id);
+    add(h, ts.tsx);
+    add(h, std::string_view{ts.name});
+    add(h, ts.tile_size);
+    add(h, *ts.spacing);
+    add(h, *ts.margin);
+    add(h, ts.size);
+    add(h, ts.tile_offset);
+    add(h, ts.properties);
+    add(h, ts.image);
+    add(h, u64{ts.tiles.size()});
+
+    for (const auto& t : ts.tiles)
+        add_tile(h, t);
+}
+
+void add(Hasher& h, const Image_collection& ts)
+{
+    add(h, u64{1});
+    add(h, *ts.first_id);
+    add(h, ts.tsx);
+    add(h, std::string_view{ts.name});
+    add(h, ts.max_tile_size);
+    add(h, *ts.tile_count);
+    add(h, *ts.columns);
+    add(h, ts.tile_offset);
+    add(h, ts.properties);
+    add(h, u64{ts.tiles.size()});
+
+    for (const auto& t : ts.tiles)
+        add_tile(h, t);
+}
+
+void add(Hasher& h, const Map::Orientation& o)
+{
+    add(h, u64{o.index()});
+
+    if (auto staggered{std::get_if<Map::Staggered>(&o)}) {
+        add(h, staggered->axis);
+        add(h, staggered->index);
+    }
+    else if (auto hexagonal{std::get_if<Map::Hexagonal>(&o)}) {
+        add(h, hexagonal->axis);
+        add(h, hexagonal->index);
+        add(h, hexagonal->side_length);
+    }
+}
+
+void add(Hasher& h, const Map& m)
+{
+    add(h, std::string_view{m.version});
+    add(h, m.orientation);
+    add(h, m.render_order);
+    add(h, m.size);
+    add(h, m.general_tile_size);
+    add(h, m.background);
+    add(h, *get(m.next_id));
+    add(h, m.properties);
+    add(h, u64{m.tile_sets.size()});
+
+    for (const auto& ts : m.tile_sets)
+        std::visit([&](const auto& ts) { add(h, ts); }, ts);
+
+    add(h, u64{m.layers.size()});
+
+    for (const auto& l : m.layers)
+        std::visit([&](const auto& l) { add(h, l); }, l);
+}
+
+template <class T>
+u64 hash(const T& x)
+{
+    Hasher h;
+    add(h, x);
+    return h.finish();
+}
+
+} // namespace
+} // namespace impl
+
+std::uint_least64_t hash(const Properties& ps)
+{
+    return impl::hash(ps);
+}
+
+std::uint_least64_t hash(const Tile_layer& l)
+{
+    return impl::hash(l);
+}
+
+std::uint_least64_t hash(const Object_layer& l)
+{
+    return impl::hash(l);
+}
+
+std::uint_least64_t hash(const Image_layer& l)
+{
+    return impl::hash(l);
+}
+
+std::uint_least64_t hash(const Map::Layer& l)
+{
+    return std::visit([](const auto& l) { return hash(l); }, l);
+}
+
+std::uint_least64_t hash(const Tile_set& ts)
+{
+    return impl::hash(ts);
+}
+
+std::uint_least64_t hash(const Image_collection& ts)
+{
+    return impl::hash(ts);
+}
+
+std::uint_least64_t hash(const Map::Tile_set& ts)
+{
+    return std::visit([](const auto& ts) { return hash(ts); }, ts);
+}
+
+std::uint_least64_t hash(const Map& map)
+{
+    return impl::hash(map);
+}
+
+} // namespace tmxpp
@@ -0,0 +1,52 @@
+#include <new>
+#include <tmxpp/impl/Block_recycler.hpp>
+
+namespace tmxpp::impl {
+
+thread_local Block_recycler* Block_recycler::current{};
+
+Block_recycler::~Block_recycler()
+{
+    release();
+}
+
+void Block_recycler::release() noexcept
+{
+    while (kept_) {
+        auto next{kept_->next};
+        ::operator delete(kept_);
+        kept_ = next;
+    }
+}
+
+void* Block_recycler::allocate(std::size_t size)
+{
+    if (current)
+        for (auto block{&current->kept_}; *block; block = &(*block)->next)
+            if ((*block)->size >= size) {
+                auto kept{*block};
+                *block = kept->next;
+                return kept + 1;
+            }
+
+    auto block{static_cast<Header*>(::operator new(sizeof(Header) + size))};
+    block->size  = size;
+    block->owner = current;
+    block->next  = nullptr;
+
+    return block + 1;
+}
+
+void Block_recycler::deallocate(void* p) noexcept
+{
+    auto block{static_cast<Header*>(p) - 1};
+
+    if (auto owner{block->owner}) {
+        block->next  = owner->kept_;
+        owner->kept_ = block;
+    }
+    else
+        ::operator delete(block);
+}
+
+} // namespace tmxpp::impl
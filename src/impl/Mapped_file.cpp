@@ -0,0 +1,107 @@
+#include <string>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Mapped_file.hpp>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define TMXPP_IMPL_MMAP
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tmxpp::impl {
+
+#ifdef TMXPP_IMPL_MMAP
+
+namespace {
+
+[[noreturn]] void throw_error(gsl::czstring<> path, gsl::czstring<> what)
+{
+    throw Exception{std::string{path} + ' ' + what + ' ' +
+                    std::strerror(errno)};
+}
+
+class File_descriptor {
+public:
+    explicit File_descriptor(gsl::czstring<> path)
+      : fd{::open(path, O_RDONLY | O_CLOEXEC)}
+    {
+        if (fd == -1)
+            throw_error(path, "could not be opened.");
+    }
+
+    File_descriptor(const File_descriptor&) = delete;
+    File_descriptor& operator=(const File_descriptor&) = delete;
+
+    ~File_descriptor()
+    {
+        ::close(fd);
+    }
+
+    const int fd;
+};
+
+} // namespace
+
+Mapped_file::Mapped_file(gsl::not_null<gsl::czstring<>> path, Access access)
+{
+    const File_descriptor file{path};
+
+    struct stat status;
+    if (::fstat(file.fd, &status) == -1)
+        throw_error(path, "could not be inspected.");
+    if (!S_ISREG(status.st_mode) || status.st_size == 0)
+        throw Exception{std::string{path} + " is empty or not a regular file."};
+
+    size_ = static_cast<std::size_t>(status.st_size);
+
+    // Reserve room for the null character in anonymous, zeroed memory, then
+    // map the file over its start. The rest of the last page of the file is
+    // zeroed too.
+    const auto page_size{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+    mapping_size_ = (size_ + 1 + page_size - 1) / page_size * page_size;
+
+    address_ = ::mmap(
+        nullptr, mapping_size_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (address_ == MAP_FAILED)
+        throw_error(path, "could not be mapped.");
+
+    if (::mmap(
+            address_, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+            file.fd, 0) == MAP_FAILED) {
+        const auto error{errno};
+        ::munmap(address_, mapping_size_);
+        errno = error;
+        throw_error(path, "could not be mapped.");
+    }
+
+    if (access == Access::sequential) {
+        ::madvise(address_, size_, MADV_SEQUENTIAL);
+        ::madvise(address_, size_, MADV_WILLNEED);
+    }
+    else
+        ::madvise(address_, size_, MADV_RANDOM);
+}
+
+Mapped_file::~Mapped_file()
+{
+    ::munmap(address_, mapping_size_);
+}
+
+#else // TMXPP_IMPL_MMAP
+
+Mapped_file::Mapped_file(gsl::not_null<gsl::czstring<>> path, Access)
+{
+    throw Exception{std::string{path} + " could not be mapped. Unsupported."};
+}
+
+Mapped_file::~Mapped_file() = default;
+
+#endif // TMXPP_IMPL_MMAP
+
+} // namespace tmxpp::impl
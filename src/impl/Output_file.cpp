@@ -0,0 +1,96 @@
+#include <charconv>
+#include <iterator>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Output_file.hpp>
+
+namespace tmxpp::impl {
+
+namespace {
+
+// The number of temporary file names tried before giving up.
+constexpr int max_attempts{64};
+
+// Returns: A random suffix for a temporary file name.
+std::string random_suffix()
+{
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+
+    char hex[16];
+    const auto end{
+        std::to_chars(std::begin(hex), std::end(hex), engine(), 16).ptr};
+
+    return '.' + std::string(std::begin(hex), end) + ".tmp";
+}
+
+} // namespace
+
+Output_file::Output_file(std::experimental::filesystem::path path)
+  : path_{std::move(path)}
+{
+    for (int attempt{0}; attempt != max_attempts; ++attempt) {
+        temporary_ = path_;
+        temporary_ += random_suffix();
+
+        // "x" creates the file exclusively, failing if it exists.
+        file_ = std::fopen(temporary_.string().c_str(), "wbx");
+
+        if (file_)
+            return;
+
+        std::error_code ec;
+        if (!std::experimental::filesystem::exists(temporary_, ec))
+            break;
+    }
+
+    throw Exception{"Output path " + path_.string() + " presented problems."};
+}
+
+Output_file::~Output_file()
+{
+    if (committed_)
+        return;
+
+    if (file_)
+        std::fclose(file_);
+
+    std::error_code ec;
+    std::experimental::filesystem::remove(temporary_, ec);
+}
+
+Sink Output_file::sink()
+{
+    return [this](std::string_view chunk) {
+        if (std::fwrite(chunk.data(), 1, chunk.size(), file_) != chunk.size())
+            throw_write_error();
+    };
+}
+
+void Output_file::close()
+{
+    const auto failed{std::fclose(std::exchange(file_, nullptr)) != 0};
+
+    if (failed)
+        throw_write_error();
+}
+
+void Output_file::commit()
+{
+    std::error_code ec;
+    std::experimental::filesystem::rename(temporary_, path_, ec);
+
+    if (ec)
+        throw_write_error();
+
+    committed_ = true;
+}
+
+void Output_file::throw_write_error() const
+{
+    throw Exception{"Could not write to " + path_.string() + '.'};
+}
+
+} // namespace tmxpp::impl
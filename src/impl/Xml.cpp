@@ -1,3 +1,8 @@
+#include <exception>
+#include <new>
+#include <string>
+#include <utility>
+#include <tmxpp/exceptions.hpp>
 #include <tmxpp/impl/Xml.hpp>
 #include <tmxpp/impl/exceptions.hpp>
 
@@ -19,4 +24,74 @@ auto Xml::Element::child(Name name) const -> Element
     throw Invalid_element{name};
 }
 
+void Xml::load(gsl::not_null<gsl::czstring<>> path) try {
+    clear();
+
+    if (auto text{map(path)})
+        doc.parse<rapidxml::parse_fastest>(text);
+    else {
+        xml.emplace(path);
+        doc.parse<rapidxml::parse_fastest>(std::as_const(xml)->data());
+    }
+
+    if (root().elem == nullptr)
+        throw Exception{std::string{path} + " has no root element."};
+}
+catch (const std::bad_alloc&) {
+    throw;
+}
+catch (const std::exception& e) {
+    throw Exception{e.what()};
+}
+
+void Xml::load(Text text) try {
+    clear();
+
+    copy.assign(get(text).begin(), get(text).end());
+    copy.push_back('\0');
+    doc.parse<rapidxml::parse_fastest>(copy.data());
+
+    if (root().elem == nullptr)
+        throw Exception{"The document has no root element."};
+}
+catch (const std::bad_alloc&) {
+    throw;
+}
+catch (const std::exception& e) {
+    throw Exception{e.what()};
+}
+
+void Xml::load(In_situ_text text) try {
+    clear();
+
+    doc.parse<rapidxml::parse_fastest>(get(text));
+
+    if (root().elem == nullptr)
+        throw Exception{"The document has no root element."};
+}
+catch (const std::bad_alloc&) {
+    throw;
+}
+catch (const std::exception& e) {
+    throw Exception{e.what()};
+}
+
+void Xml::clear() noexcept
+{
+    doc.clear();
+    mapping.reset();
+    xml.reset();
+    copy.clear();
+}
+
+char* Xml::map(gsl::not_null<gsl::czstring<>> path) noexcept
+{
+    try {
+        return mapping.emplace(path).data();
+    }
+    catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
 } // namespace tmxpp::impl
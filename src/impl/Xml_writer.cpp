@@ -0,0 +1,143 @@
+#include <utility>
+#include <tmxpp/impl/Xml_writer.hpp>
+
+namespace tmxpp::impl {
+
+namespace {
+
+// The number of characters buffered before they are passed to the sink.
+constexpr std::size_t buffer_size{64 * 1024};
+
+} // namespace
+
+Xml_writer::Xml_writer(Sink sink, Element::Name name) : sink_{std::move(sink)}
+{
+    buffer_.reserve(buffer_size);
+
+    put('<');
+    put(get(name));
+    open_.push_back({get(name), false, false});
+    start_tag_open_ = true;
+}
+
+void Xml_writer::finish()
+{
+    end(0);
+    flush();
+}
+
+void Xml_writer::start(std::size_t depth, Element::Name name)
+{
+    end(depth);
+    close_start_tag();
+
+    auto& parent{open_.back()};
+
+    if (!parent.has_children) {
+        parent.has_children = true;
+        put('\n');
+    }
+
+    for (std::size_t i{0}; i != open_.size(); ++i)
+        put('\t');
+
+    put('<');
+    put(get(name));
+    open_.push_back({get(name), false, false});
+    start_tag_open_ = true;
+}
+
+void Xml_writer::attribute(
+    Xml::Attribute::Name name, Xml::Attribute::Value value)
+{
+    put(' ');
+    put(get(name));
+    put("=\"");
+    put_escaped(get(value), "&<>\"");
+    put('"');
+}
+
+void Xml_writer::value(std::string_view value)
+{
+    close_start_tag();
+    put_escaped(value, "&<>");
+    open_.back().has_value = true;
+}
+
+void Xml_writer::end(std::size_t depth)
+{
+    while (open_.size() > depth) {
+        const auto element{open_.back()};
+        open_.pop_back();
+
+        if (start_tag_open_) {
+            start_tag_open_ = false;
+            put("/>\n");
+            continue;
+        }
+
+        if (element.has_children)
+            for (std::size_t i{0}; i != open_.size(); ++i)
+                put('\t');
+
+        put("</");
+        put(element.name);
+        put(">\n");
+    }
+}
+
+void Xml_writer::close_start_tag()
+{
+    if (start_tag_open_) {
+        start_tag_open_ = false;
+        put('>');
+    }
+}
+
+void Xml_writer::put(std::string_view s)
+{
+    if (buffer_.size() + s.size() > buffer_size)
+        flush();
+
+    if (s.size() >= buffer_size)
+        sink_(s);
+    else
+        buffer_.append(s);
+}
+
+void Xml_writer::put(char c)
+{
+    if (buffer_.size() == buffer_size)
+        flush();
+
+    buffer_.push_back(c);
+}
+
+void Xml_writer::put_escaped(std::string_view s, std::string_view special)
+{
+    for (auto i{s.find_first_of(special)}; i != std::string_view::npos;
+         i = s.find_first_of(special)) {
+        put(s.substr(0, i));
+
+        switch (s[i]) {
+        case '&': put("&amp;"); break;
+        case '<': put("&lt;"); break;
+        case '>': put("&gt;"); break;
+        case '"': put("&quot;"); break;
+        }
+
+        s.remove_prefix(i + 1);
+    }
+
+    put(s);
+}
+
+void Xml_writer::flush()
+{
+    if (!buffer_.empty())
+        sink_(buffer_);
+
+    buffer_.clear();
+}
+
+} // namespace tmxpp::impl
@@ -0,0 +1,315 @@
+#include <array>
+#include <cstring>
+#include <tmxpp/impl/base64.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define TMXPP_IMPL_BASE64_X86
+#include <immintrin.h>
+#endif
+
+namespace tmxpp::impl::base64 {
+
+namespace {
+
+constexpr char alphabet[]{
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+
+// Values of `decode_table` which are not sextets.
+constexpr unsigned char invalid{0xFF};
+constexpr unsigned char whitespace{0xFE};
+constexpr unsigned char pad{0xFD};
+
+constexpr std::array<unsigned char, 256> make_decode_table() noexcept
+{
+    std::array<unsigned char, 256> table{};
+
+    for (auto& sextet : table)
+        sextet = invalid;
+    for (unsigned char i{0}; i != 64; ++i)
+        table[static_cast<unsigned char>(alphabet[i])] = i;
+    for (unsigned char c : {' ', '\t', '\n', '\r'})
+        table[c] = whitespace;
+    table['='] = pad;
+
+    return table;
+}
+
+constexpr auto decode_table{make_decode_table()};
+
+using Decode_quanta =
+    std::size_t (*)(const char*, std::size_t, unsigned char*) noexcept;
+
+// Effects: Decodes the leading 4-character quanta of `in` which have neither
+//          whitespace nor padding into `out`.
+// Returns: The number of characters decoded. Three fourths of it is the number
+//          of bytes written.
+std::size_t decode_quanta_scalar(
+    const char* in, std::size_t size, unsigned char* out) noexcept
+{
+    std::size_t i{0};
+
+    for (; size - i >= 4; i += 4) {
+        const std::uint_least32_t a{
+            decode_table[static_cast<unsigned char>(in[i])]};
+        const std::uint_least32_t b{
+            decode_table[static_cast<unsigned char>(in[i + 1])]};
+        const std::uint_least32_t c{
+            decode_table[static_cast<unsigned char>(in[i + 2])]};
+        const std::uint_least32_t d{
+            decode_table[static_cast<unsigned char>(in[i + 3])]};
+
+        if ((a | b | c | d) & 0xC0)
+            break;
+
+        const auto bits{a << 18 | b << 12 | c << 6 | d};
+        *out++ = static_cast<unsigned char>(bits >> 16);
+        *out++ = static_cast<unsigned char>(bits >> 8);
+        *out++ = static_cast<unsigned char>(bits);
+    }
+
+    return i;
+}
+
+#ifdef TMXPP_IMPL_BASE64_X86
+
+// The SIMD kernels translate characters to sextets by adding a per-range
+// offset, then merge each four sextets into three bytes with multiply-adds.
+
+#define TMXPP_IMPL_TARGET(isa) __attribute__((target(isa)))
+
+TMXPP_IMPL_TARGET("ssse3")
+__m128i in_range(__m128i c, char first, char last) noexcept
+{
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(c, _mm_set1_epi8(static_cast<char>(first - 1))),
+        _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(last + 1)), c));
+}
+
+TMXPP_IMPL_TARGET("ssse3")
+std::size_t decode_quanta_ssse3(
+    const char* in, std::size_t size, unsigned char* out) noexcept
+{
+    std::size_t i{0};
+
+    for (; size - i >= 16; i += 16) {
+        const auto c{_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))};
+
+        const auto upper{in_range(c, 'A', 'Z')};
+        const auto lower{in_range(c, 'a', 'z')};
+        const auto digit{in_range(c, '0', '9')};
+        const auto plus{_mm_cmpeq_epi8(c, _mm_set1_epi8('+'))};
+        const auto slash{_mm_cmpeq_epi8(c, _mm_set1_epi8('/'))};
+
+        const auto valid{_mm_or_si128(
+            _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, plus)),
+            slash)};
+
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+            break;
+
+        const auto shift{_mm_or_si128(
+            _mm_or_si128(
+                _mm_or_si128(
+                    _mm_and_si128(upper, _mm_set1_epi8(-65)),
+                    _mm_and_si128(lower, _mm_set1_epi8(-71))),
+                _mm_or_si128(
+                    _mm_and_si128(digit, _mm_set1_epi8(4)),
+                    _mm_and_si128(plus, _mm_set1_epi8(19)))),
+            _mm_and_si128(slash, _mm_set1_epi8(16)))};
+
+        const auto sextets{_mm_add_epi8(c, shift)};
+        const auto pairs{
+            _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x0140'0140))};
+        const auto triples{_mm_madd_epi16(pairs, _mm_set1_epi32(0x0001'1000))};
+        const auto bytes{_mm_shuffle_epi8(
+            triples, _mm_setr_epi8(
+                         2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                         -1))};
+
+        unsigned char block[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block), bytes);
+        std::memcpy(out, block, 12);
+        out += 12;
+    }
+
+    return i + decode_quanta_scalar(in + i, size - i, out);
+}
+
+TMXPP_IMPL_TARGET("avx2")
+__m256i in_range(__m256i c, char first, char last) noexcept
+{
+    return _mm256_and_si256(
+        _mm256_cmpgt_epi8(c, _mm256_set1_epi8(static_cast<char>(first - 1))),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(last + 1)), c));
+}
+
+TMXPP_IMPL_TARGET("avx2")
+std::size_t decode_quanta_avx2(
+    const char* in, std::size_t size, unsigned char* out) noexcept
+{
+    std::size_t i{0};
+
+    for (; size - i >= 32; i += 32) {
+        const auto c{
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))};
+
+        const auto upper{in_range(c, 'A', 'Z')};
+        const auto lower{in_range(c, 'a', 'z')};
+        const auto digit{in_range(c, '0', '9')};
+        const auto plus{_mm256_cmpeq_epi8(c, _mm256_set1_epi8('+'))};
+        const auto slash{_mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'))};
+
+        const auto valid{_mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_or_si256(upper, lower), _mm256_or_si256(digit, plus)),
+            slash)};
+
+        if (_mm256_movemask_epi8(valid) != -1)
+            break;
+
+        const auto shift{_mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_and_si256(upper, _mm256_set1_epi8(-65)),
+                    _mm256_and_si256(lower, _mm256_set1_epi8(-71))),
+                _mm256_or_si256(
+                    _mm256_and_si256(digit, _mm256_set1_epi8(4)),
+                    _mm256_and_si256(plus, _mm256_set1_epi8(19)))),
+            _mm256_and_si256(slash, _mm256_set1_epi8(16)))};
+
+        const auto sextets{_mm256_add_epi8(c, shift)};
+        const auto pairs{
+            _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x0140'0140))};
+        const auto triples{
+            _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x0001'1000))};
+        const auto lanes{_mm256_shuffle_epi8(
+            triples, _mm256_setr_epi8(
+                         2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                         -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                         -1, -1))};
+        const auto bytes{_mm256_permutevar8x32_epi32(
+            lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7))};
+
+        unsigned char block[32];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(block), bytes);
+        std::memcpy(out, block, 24);
+        out += 24;
+    }
+
+    return i + decode_quanta_ssse3(in + i, size - i, out);
+}
+
+#undef TMXPP_IMPL_TARGET
+
+#endif // TMXPP_IMPL_BASE64_X86
+
+Decode_quanta select_decode_quanta() noexcept
+{
+#ifdef TMXPP_IMPL_BASE64_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return decode_quanta_avx2;
+    if (__builtin_cpu_supports("ssse3"))
+        return decode_quanta_ssse3;
+#endif
+    return decode_quanta_scalar;
+}
+
+const Decode_quanta decode_quanta{select_decode_quanta()};
+
+} // namespace
+
+std::optional<std::size_t> Decoder::decode(
+    std::string_view in, unsigned char* out) noexcept
+{
+    auto first{in.data()};
+    const auto last{first + in.size()};
+    const auto out_first{out};
+
+    while (first != last) {
+        if (pending_ == 0 && !done_) {
+            const auto decoded{
+                decode_quanta(first, static_cast<std::size_t>(last - first), out)};
+
+            first += decoded;
+            out += decoded / 4 * 3;
+
+            if (first == last)
+                break;
+        }
+
+        const auto c{decode_table[static_cast<unsigned char>(*first++)]};
+
+        if (c == whitespace)
+            continue;
+
+        if (c == pad) {
+            if (done_ ? padding_ == 0 : pending_ < 2)
+                return {};
+
+            if (!done_) {
+                if (pending_ == 2)
+                    *out++ = static_cast<unsigned char>(bits_ >> 4);
+                else {
+                    *out++ = static_cast<unsigned char>(bits_ >> 10);
+                    *out++ = static_cast<unsigned char>(bits_ >> 2);
+                }
+                done_    = true;
+                padding_ = 4 - pending_;
+                pending_ = 0;
+            }
+
+            --padding_;
+            continue;
+        }
+
+        if (c == invalid || done_)
+            return {};
+
+        bits_ = bits_ << 6 | c;
+
+        if (++pending_ == 4) {
+            *out++   = static_cast<unsigned char>(bits_ >> 16);
+            *out++   = static_cast<unsigned char>(bits_ >> 8);
+            *out++   = static_cast<unsigned char>(bits_);
+            bits_    = 0;
+            pending_ = 0;
+        }
+    }
+
+    return static_cast<std::size_t>(out - out_first);
+}
+
+std::string encode(const unsigned char* in, std::size_t size)
+{
+    std::string out(encoded_size(size), '=');
+    auto o{out.data()};
+    std::size_t i{0};
+
+    for (; size - i >= 3; i += 3) {
+        const std::uint_least32_t bits{
+            static_cast<std::uint_least32_t>(in[i]) << 16 |
+            static_cast<std::uint_least32_t>(in[i + 1]) << 8 | in[i + 2]};
+
+        *o++ = alphabet[bits >> 18];
+        *o++ = alphabet[bits >> 12 & 0x3F];
+        *o++ = alphabet[bits >> 6 & 0x3F];
+        *o++ = alphabet[bits & 0x3F];
+    }
+
+    if (const auto rest{size - i}) {
+        std::uint_least32_t bits{static_cast<std::uint_least32_t>(in[i]) << 16};
+        if (rest == 2)
+            bits |= static_cast<std::uint_least32_t>(in[i + 1]) << 8;
+
+        *o++ = alphabet[bits >> 18];
+        *o++ = alphabet[bits >> 12 & 0x3F];
+        if (rest == 2)
+            *o = alphabet[bits >> 6 & 0x3F];
+    }
+
+    return out;
+}
+
+} // namespace tmxpp::impl::base64
@@ -0,0 +1,250 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <zlib.h>
+#include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/base64.hpp>
+#include <tmxpp/impl/compression.hpp>
+#include <tmxpp/impl/exceptions.hpp>
+
+#ifdef TMXPP_ZSTD
+#include <memory>
+#include <zstd.h>
+#endif
+
+namespace tmxpp::impl::compression {
+
+namespace {
+
+// The number of base64 characters decoded and decompressed at a time.
+constexpr std::size_t block_size{64 * 1024};
+
+uInt to_uInt(std::size_t size)
+{
+    if (size > std::numeric_limits<uInt>::max())
+        throw Exception{"Data too large for zlib."};
+    return static_cast<uInt>(size);
+}
+
+// Inflates a zlib or gzip stream into a fixed output buffer.
+class Zlib_inflater {
+public:
+    Zlib_inflater(Data::Compression c, unsigned char* out, std::size_t size)
+    {
+        stream_.next_out  = out;
+        stream_.avail_out = to_uInt(size);
+
+        if (inflateInit2(&stream_, window_bits(c)) != Z_OK)
+            throw Exception{"Could not initialize zlib."};
+    }
+
+    Zlib_inflater(const Zlib_inflater&) = delete;
+    Zlib_inflater& operator=(const Zlib_inflater&) = delete;
+
+    ~Zlib_inflater()
+    {
+        inflateEnd(&stream_);
+    }
+
+    void inflate(const unsigned char* in, std::size_t size)
+    {
+        stream_.next_in  = const_cast<unsigned char*>(in);
+        stream_.avail_in = to_uInt(size);
+
+        while (stream_.avail_in != 0) {
+            if (ended_)
+                throw Exception{"Trailing data after compressed data."};
+
+            auto result{::inflate(&stream_, Z_NO_FLUSH)};
+
+            if (result == Z_STREAM_END)
+                ended_ = true;
+            else if (result == Z_BUF_ERROR && stream_.avail_out == 0)
+                throw Exception{"Data size does not match layer size."};
+            else if (result != Z_OK)
+                throw Exception{
+                    "Bad compressed data. " +
+                    std::string{stream_.msg ? stream_.msg : ""}};
+        }
+    }
+
+    bool ended() const noexcept
+    {
+        return ended_;
+    }
+
+    std::size_t written() const noexcept
+    {
+        return stream_.total_out;
+    }
+
+    static int window_bits(Data::Compression c)
+    {
+        switch (c) {
+        case Data::Compression::zlib: return MAX_WBITS;
+        case Data::Compression::gzip: return MAX_WBITS + 16;
+        default: throw Invalid_enum{"Invalid Data::Compression.", c};
+        }
+    }
+
+private:
+    z_stream stream_{};
+    bool ended_{};
+};
+
+#ifdef TMXPP_ZSTD
+
+// Inflates a zstd stream into a fixed output buffer.
+class Zstd_inflater {
+public:
+    Zstd_inflater(unsigned char* out, std::size_t size)
+      : stream_{ZSTD_createDStream()}, out_{out, size, 0}
+    {
+        if (!stream_ || ZSTD_isError(ZSTD_initDStream(stream_.get())))
+            throw Exception{"Could not initialize zstd."};
+    }
+
+    void inflate(const unsigned char* in, std::size_t size)
+    {
+        ZSTD_inBuffer input{in, size, 0};
+
+        while (input.pos != input.size) {
+            const auto consumed{input.pos};
+            const auto produced{out_.pos};
+
+            auto result{ZSTD_decompressStream(stream_.get(), &out_, &input)};
+
+            if (ZSTD_isError(result))
+                throw Exception{
+                    std::string{"Bad compressed data. "} +
+                    ZSTD_getErrorName(result)};
+
+            ended_ = result == 0;
+
+            if (input.pos == consumed && out_.pos == produced)
+                throw Exception{"Data size does not match layer size."};
+        }
+    }
+
+    bool ended() const noexcept
+    {
+        return ended_;
+    }
+
+    std::size_t written() const noexcept
+    {
+        return out_.pos;
+    }
+
+private:
+    struct Deleter {
+        void operator()(ZSTD_DStream* stream) const noexcept
+        {
+            ZSTD_freeDStream(stream);
+        }
+    };
+
+    std::unique_ptr<ZSTD_DStream, Deleter> stream_;
+    ZSTD_outBuffer out_;
+    bool ended_{};
+};
+
+#endif // TMXPP_ZSTD
+
+template <class Inflater>
+std::size_t inflate(std::string_view data, Inflater&& inflater)
+{
+    std::vector<unsigned char> block(base64::decoded_size_bound(block_size));
+    base64::Decoder decoder;
+
+    for (std::size_t i{0}; i < data.size(); i += block_size) {
+        auto decoded{decoder.decode(data.substr(i, block_size), block.data())};
+
+        if (!decoded)
+            throw Exception{"Bad base64-encoded data."};
+
+        inflater.inflate(block.data(), *decoded);
+    }
+
+    if (!decoder.finished())
+        throw Exception{"Bad base64-encoded data."};
+    if (!inflater.ended())
+        throw Exception{"Truncated compressed data."};
+
+    return inflater.written();
+}
+
+std::vector<unsigned char> deflate_zlib(
+    const unsigned char* in, std::size_t size, Data::Compression c)
+{
+    struct Stream : z_stream {
+        Stream() : z_stream{}
+        {
+        }
+        ~Stream()
+        {
+            deflateEnd(this);
+        }
+    } stream;
+
+    if (deflateInit2(
+            &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+            Zlib_inflater::window_bits(c), 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        throw Exception{"Could not initialize zlib."};
+
+    std::vector<unsigned char> out(deflateBound(&stream, to_uInt(size)));
+
+    stream.next_in   = const_cast<unsigned char*>(in);
+    stream.avail_in  = to_uInt(size);
+    stream.next_out  = out.data();
+    stream.avail_out = to_uInt(out.size());
+
+    if (::deflate(&stream, Z_FINISH) != Z_STREAM_END)
+        throw Exception{"Could not compress data."};
+
+    out.resize(stream.total_out);
+    return out;
+}
+
+} // namespace
+
+std::size_t inflate(
+    std::string_view data, Data::Compression c, unsigned char* out,
+    std::size_t size)
+{
+    if (c == Data::Compression::zstd) {
+#ifdef TMXPP_ZSTD
+        return inflate(data, Zstd_inflater{out, size});
+#else
+        throw Exception{"zstd-compressed data is not supported."};
+#endif
+    }
+
+    return inflate(data, Zlib_inflater{c, out, size});
+}
+
+std::vector<unsigned char> deflate(
+    const unsigned char* in, std::size_t size, Data::Compression c)
+{
+    if (c != Data::Compression::zstd)
+        return deflate_zlib(in, size, c);
+
+#ifdef TMXPP_ZSTD
+    std::vector<unsigned char> out(ZSTD_compressBound(size));
+
+    auto result{ZSTD_compress(
+        out.data(), out.size(), in, size, ZSTD_CLEVEL_DEFAULT)};
+
+    if (ZSTD_isError(result))
+        throw Exception{
+            std::string{"Could not compress data. "} +
+            ZSTD_getErrorName(result)};
+
+    out.resize(result);
+    return out;
+#else
+    throw Exception{"zstd-compressed data is not supported."};
+#endif
+}
+
+} // namespace tmxpp::impl::compression
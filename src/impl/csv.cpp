@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <cstring>
+#include <tmxpp/impl/csv.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define TMXPP_IMPL_CSV_X86
+#include <immintrin.h>
+#endif
+
+namespace tmxpp::impl::csv {
+
+namespace {
+
+// The input is classified in blocks of 64 characters, each described by a
+// `Mask` whose bits are set for the digits. The tokens are then found by
+// scanning the set bits, so separators are never looked at one by one.
+using Mask = std::uint_least64_t;
+
+constexpr std::size_t block_size{64};
+constexpr std::size_t chunk_blocks{64};
+
+// More digits could overflow the accumulator. Valid ids have at most 10.
+constexpr int max_digits{19};
+
+constexpr bool is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool is_separator(char c) noexcept
+{
+    return c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+using Classify = bool (*)(const char*, std::size_t, Mask*) noexcept;
+
+// Effects: Stores the digits `Mask` of each of the `blocks` blocks of `in` into
+//          `digits`.
+// Returns: `true` if every character of `in` is a digit or a separator, and
+//          `false` otherwise.
+bool classify_scalar(const char* in, std::size_t blocks, Mask* digits) noexcept
+{
+    bool valid{true};
+
+    for (std::size_t b{0}; b != blocks; ++b, in += block_size) {
+        Mask mask{};
+
+        for (std::size_t i{0}; i != block_size; ++i) {
+            mask |= Mask{is_digit(in[i])} << i;
+            valid &= is_digit(in[i]) || is_separator(in[i]);
+        }
+
+        digits[b] = mask;
+    }
+
+    return valid;
+}
+
+#ifdef TMXPP_IMPL_CSV_X86
+
+#define TMXPP_IMPL_TARGET(isa) __attribute__((target(isa)))
+
+TMXPP_IMPL_TARGET("sse2")
+bool classify_sse2(const char* in, std::size_t blocks, Mask* digits) noexcept
+{
+    const auto before_zero{_mm_set1_epi8('0' - 1)};
+    const auto after_nine{_mm_set1_epi8('9' + 1)};
+    Mask valid{~Mask{}};
+
+    for (std::size_t b{0}; b != blocks; ++b, in += block_size) {
+        Mask digit_mask{};
+        Mask separator_mask{};
+
+        for (int i{0}; i != 4; ++i) {
+            const auto c{
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i)};
+
+            const auto digit{_mm_and_si128(
+                _mm_cmpgt_epi8(c, before_zero), _mm_cmpgt_epi8(after_nine, c))};
+            const auto separator{_mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(c, _mm_set1_epi8(',')),
+                    _mm_cmpeq_epi8(c, _mm_set1_epi8(' '))),
+                _mm_or_si128(
+                    _mm_or_si128(
+                        _mm_cmpeq_epi8(c, _mm_set1_epi8('\n')),
+                        _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'))),
+                    _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'))))};
+
+            digit_mask |= Mask{static_cast<unsigned>(_mm_movemask_epi8(digit))}
+                          << 16 * i;
+            separator_mask |=
+                Mask{static_cast<unsigned>(_mm_movemask_epi8(separator))}
+                << 16 * i;
+        }
+
+        digits[b] = digit_mask;
+        valid &= digit_mask | separator_mask;
+    }
+
+    return valid == ~Mask{};
+}
+
+TMXPP_IMPL_TARGET("avx2")
+bool classify_avx2(const char* in, std::size_t blocks, Mask* digits) noexcept
+{
+    const auto before_zero{_mm256_set1_epi8('0' - 1)};
+    const auto after_nine{_mm256_set1_epi8('9' + 1)};
+    Mask valid{~Mask{}};
+
+    for (std::size_t b{0}; b != blocks; ++b, in += block_size) {
+        Mask digit_mask{};
+        Mask separator_mask{};
+
+        for (int i{0}; i != 2; ++i) {
+            const auto c{
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in) + i)};
+
+            const auto digit{_mm256_and_si256(
+                _mm256_cmpgt_epi8(c, before_zero),
+                _mm256_cmpgt_epi8(after_nine, c))};
+            const auto separator{_mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_cmpeq_epi8(c, _mm256_set1_epi8(',')),
+                    _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' '))),
+                _mm256_or_si256(
+                    _mm256_or_si256(
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')),
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r'))),
+                    _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t'))))};
+
+            digit_mask |=
+                Mask{static_cast<std::uint_least32_t>(
+                    _mm256_movemask_epi8(digit))}
+                << 32 * i;
+            separator_mask |=
+                Mask{static_cast<std::uint_least32_t>(
+                    _mm256_movemask_epi8(separator))}
+                << 32 * i;
+        }
+
+        digits[b] = digit_mask;
+        valid &= digit_mask | separator_mask;
+    }
+
+    return valid == ~Mask{};
+}
+
+#undef TMXPP_IMPL_TARGET
+
+#endif // TMXPP_IMPL_CSV_X86
+
+Classify select_classify() noexcept
+{
+#ifdef TMXPP_IMPL_CSV_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return classify_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return classify_sse2;
+#endif
+    return classify_scalar;
+}
+
+const Classify classify{select_classify()};
+
+int count_trailing_zeros(Mask m) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(m);
+#else
+    int n{0};
+    for (; !(m & 1); m >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+} // namespace
+
+std::optional<std::size_t> parse_ids(
+    std::string_view data, std::uint_least32_t* out, std::size_t size) noexcept
+{
+    Mask digits[chunk_blocks];
+    char tail[block_size];
+
+    std::size_t count{0};
+    std::uint_least64_t value{0};
+    int length{0};
+
+    auto emit = [&] {
+        if (value > 0xFFFF'FFFF)
+            return false;
+        if (count < size)
+            out[count] = static_cast<std::uint_least32_t>(value);
+        ++count;
+        value  = 0;
+        length = 0;
+        return true;
+    };
+
+    for (auto first{data.data()}, last{first + data.size()}; first != last;) {
+        const auto remaining{static_cast<std::size_t>(last - first)};
+        auto chunk{first};
+        std::size_t blocks{1};
+
+        if (remaining >= block_size)
+            blocks = std::min(remaining / block_size, chunk_blocks);
+        else {
+            std::memset(tail, ' ', block_size);
+            std::memcpy(tail, first, remaining);
+            chunk = tail;
+        }
+
+        if (!classify(chunk, blocks, digits))
+            return {};
+
+        for (std::size_t b{0}; b != blocks; ++b) {
+            const auto block{chunk + b * block_size};
+            auto mask{digits[b]};
+
+            if (length != 0 && !(mask & 1) && !emit())
+                return {};
+
+            while (mask) {
+                const auto start{count_trailing_zeros(mask)};
+                const auto run{~(mask >> start)};
+                const auto run_length{
+                    run == 0 ? static_cast<int>(block_size) - start
+                             : count_trailing_zeros(run)};
+                const auto end{start + run_length};
+
+                if ((length += run_length) > max_digits)
+                    return {};
+
+                for (auto i{start}; i != end; ++i)
+                    value = value * 10 + static_cast<unsigned>(block[i] - '0');
+
+                if (end == static_cast<int>(block_size))
+                    break;
+                if (!emit())
+                    return {};
+
+                mask &= ~Mask{} << end;
+            }
+        }
+
+        first += std::min(remaining, blocks * block_size);
+    }
+
+    if (length != 0 && !emit())
+        return {};
+
+    return count;
+}
+
+} // namespace tmxpp::impl::csv
@@ -1,16 +1,31 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
+#include <vector>
+#include <gsl/gsl>
+#include <boost/hana/functional/overload.hpp>
 #include <tmxpp.hpp>
 #include <tmxpp/Constrained.hpp>
+#include <tmxpp/Reader.hpp>
+#include <tmxpp/Tsx_cache.hpp>
 #include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Block_recycler.hpp>
 #include <tmxpp/impl/Xml.hpp>
+#include <tmxpp/impl/base64.hpp>
+#include <tmxpp/impl/compression.hpp>
+#include <tmxpp/impl/csv.hpp>
 #include <tmxpp/impl/exceptions.hpp>
+#include <tmxpp/impl/little_endian.hpp>
+#include <tmxpp/impl/parallel.hpp>
 #include <tmxpp/impl/read_utility.hpp>
 #include <tmxpp/impl/tmx_info.hpp>
 #include <tmxpp/impl/to_color.hpp>
-#include <tmxpp/impl/to_data_flipped_id.hpp>
-#include <tmxpp/impl/to_point.hpp>
+#include <tmxpp/impl/to_points.hpp>
 
 namespace tmxpp {
 
@@ -49,17 +64,17 @@ pxSize read_tile_size(Xml::Element element)
 
 namespace properties {
 
-Property::Value read_value(Xml::Element property)
+tmx::Property_view::Value read_value_view(Xml::Element property)
 {
     auto value{optional_value(property, property_value)};
 
     if (!value)
-        return std::string{get(property.value())};
+        return get(property.value());
 
     auto alternative{optional_value(property, property_alternative)};
 
     if (!alternative || *alternative == property_alternative_string)
-        return std::string{get(*value)};
+        return get(*value);
     if (*alternative == property_alternative_int)
         return from_string<int>(*value);
     if (*alternative == property_alternative_double)
@@ -74,15 +89,27 @@ Property::Value read_value(Xml::Element property)
     if (*alternative == property_alternative_color)
         return to_color(*value);
     if (*alternative == property_alternative_file)
-        return File{get(*value)};
+        return File_view{get(*value)};
 
     throw Invalid_attribute{property_alternative, *alternative};
 }
 
-Non_empty<std::string> read_name(Xml::Element property)
+Property::Value read_value(Xml::Element property)
 {
-    return Non_empty<std::string>{
-        std::string{get(value(property, property_name))}};
+    return std::visit(
+        boost::hana::overload(
+            [](std::string_view s) -> Property::Value {
+                return model_string(s);
+            },
+            [](File_view f) -> Property::Value { return File{get(f)}; },
+            [](auto x) -> Property::Value { return x; }),
+        read_value_view(property));
+}
+
+Non_empty<std::pmr::string> read_name(Xml::Element property)
+{
+    return Non_empty<std::pmr::string>{
+        model_string(get(value(property, property_name)))};
 }
 
 Property read_property(Xml::Element property)
@@ -182,10 +209,10 @@ File read_tsx(Xml::Element tile_set)
     return {};
 }
 
-std::string read_name(Xml::Element tile_set)
+std::pmr::string read_name(Xml::Element tile_set)
 {
     if (auto name{optional_value(tile_set, tile_set_name)})
-        return std::string{get(*name)};
+        return model_string(get(*name));
     return {};
 }
 
@@ -320,7 +347,7 @@ bool is_tile_set(Xml::Element tile_set)
 }
 
 Map::Tile_set read_map_tile_set(
-    Xml::Element tile_set, const std::experimental::filesystem::path& tsx_base)
+    Xml::Element tile_set, const Tsx_resolver& resolve_tsx)
 {
     auto first_id{read_first_id(tile_set)};
     auto tsx{read_tsx(tile_set)};
@@ -331,7 +358,11 @@ Map::Tile_set read_map_tile_set(
         return image_collection::read_image_collection(tile_set, first_id, tsx);
     }
 
-    return read_tsx(first_id, std::move(tsx), tsx_base);
+    if (!resolve_tsx)
+        throw Exception{"No resolver for the external tile set " +
+                        tsx.string() + '.'};
+
+    return resolve_tsx(first_id, std::move(tsx));
 }
 
 } // namespace tile_set
@@ -362,6 +393,10 @@ Data::Compression read_compression(Xml::Element data)
         return Data::Compression::none;
     if (*compression == data_compression_zlib)
         return Data::Compression::zlib;
+    if (*compression == data_compression_gzip)
+        return Data::Compression::gzip;
+    if (*compression == data_compression_zstd)
+        return Data::Compression::zstd;
 
     throw Invalid_attribute{data_compression, *compression};
 }
@@ -371,20 +406,108 @@ Data::Format read_format(Xml::Element data)
     return {read_encoding(data), read_compression(data)};
 }
 
-Data::Flipped_ids read_ids(Data::Format format, Xml::Element::Value data)
+using Raw_ids = std::vector<Data::Flipped_ids::raw_type>;
+
+static_assert(sizeof(Raw_ids::value_type) == 4);
+
+// Returns: The `count` raw tile ids in the csv `data`.
+// Throws: `Exception` if `data` is not that.
+Raw_ids read_csv_ids(std::string_view data, std::size_t count)
+{
+    Raw_ids ids(count);
+
+    auto parsed{csv::parse_ids(data, ids.data(), count)};
+
+    if (!parsed)
+        throw Exception{"Bad csv-encoded data."};
+    if (*parsed != count)
+        throw Exception{"Data size does not match layer size."};
+
+    return ids;
+}
+
+// Returns: The `count` little endian raw tile ids in the base64 `data`.
+// Throws: `Exception` if `data` is not that.
+Raw_ids read_base64_ids(std::string_view data, std::size_t count)
+{
+    Raw_ids ids(std::max(
+        count, (base64::decoded_size_bound(data.size()) + 3) / 4));
+
+    base64::Decoder decoder;
+    auto decoded{
+        decoder.decode(data, reinterpret_cast<unsigned char*>(ids.data()))};
+
+    if (!decoded || !decoder.finished())
+        throw Exception{"Bad base64-encoded data."};
+    if (*decoded != count * sizeof(Raw_ids::value_type))
+        throw Exception{"Data size does not match layer size."};
+
+    ids.resize(count);
+    return ids;
+}
+
+// Returns: The `count` little endian raw tile ids in the base64 `data`
+//          compressed as `c`.
+// Throws: `Exception` if `data` is not that.
+Raw_ids read_compressed_ids(
+    std::string_view data, Data::Compression c, std::size_t count)
+{
+    Raw_ids ids(count);
+    const auto size{count * sizeof(Raw_ids::value_type)};
+
+    if (compression::inflate(
+            data, c, reinterpret_cast<unsigned char*>(ids.data()), size) !=
+        size)
+        throw Exception{"Data size does not match layer size."};
+
+    return ids;
+}
+
+Raw_ids to_native(Raw_ids little_endian_ids)
+{
+    for (auto& id : little_endian_ids)
+        id = little_endian(id);
+
+    return little_endian_ids;
+}
+
+// Returns: The raw tile ids of the `size`d layer in `data` of `format`.
+// Throws: `Exception` if `data` is not that.
+Raw_ids read_raw_ids(Data::Format format, std::string_view data, iSize size)
+{
+    const auto count{static_cast<std::size_t>(*size.w) * *size.h};
+
+    if (format == Data::Encoding::csv)
+        return read_csv_ids(data, count);
+
+    if (format.compression() == Data::Compression::none)
+        return to_native(read_base64_ids(data, count));
+
+    return to_native(read_compressed_ids(data, format.compression(), count));
+}
+
+// Notes: Only compressed data is deferred, as its copy is smaller than its
+//        decoded tile ids, while a copy of csv or uncompressed base64 data is
+//        larger.
+Data::Flipped_ids read_ids(
+    Data::Format format, Xml::Element::Value data, iSize size,
+    const Read_options& options)
 {
-    if (format != Data::Encoding::csv)
-        throw Exception{"Can only handle csv-encoded data."};
+    if (!options.lazy_tile_data ||
+        format.compression() == Data::Compression::none)
+        return Data::Flipped_ids(read_raw_ids(format, get(data), size));
 
-    return transform<Data::Flipped_ids>(
-        tokenize(get(data), ",\n"), to_data_flipped_id);
+    return Data::Flipped_ids{Data::Flipped_ids::Decoder{
+        [format, data = std::string{get(data)}, size] {
+            return read_raw_ids(format, data, size);
+        }}};
 }
 
-Data read_data(Xml::Element data)
+Data read_data(Xml::Element data, iSize size, const Read_options& options)
 {
     auto format{read_format(data)};
 
-    return {format, read_ids(format, data.value())};
+    return {format, read_ids(format, data.value(), size, options)};
 }
 
 } // namespace data
@@ -393,10 +516,10 @@ using data::read_data;
 
 namespace layer {
 
-std::string read_name(Xml::Element layer)
+std::pmr::string read_name(Xml::Element layer)
 {
     if (auto name{optional_value(layer, layer_name)})
-        return std::string{get(*name)};
+        return model_string(get(*name));
     return {};
 }
 
@@ -435,10 +558,13 @@ using layer::read_layer;
 
 namespace tile_layer {
 
-Tile_layer read_tile_layer(Xml::Element tile_layer)
+Tile_layer read_tile_layer(
+    Xml::Element tile_layer, const Read_options& options)
 {
-    return {read_layer(tile_layer), read_isize(tile_layer),
-            read_data(tile_layer.child(tmx_info::data))};
+    auto size{read_isize(tile_layer)};
+
+    return {read_layer(tile_layer), size,
+            read_data(tile_layer.child(tmx_info::data), size, options)};
 }
 
 } // namespace tile_layer
@@ -452,17 +578,17 @@ Unique_id read_unique_id(Xml::Element object)
     return from_string<Unique_id>(value(object, object_unique_id));
 }
 
-std::string read_name(Xml::Element object)
+std::pmr::string read_name(Xml::Element object)
 {
     if (auto name{optional_value(object, object_name)})
-        return std::string{get(*name)};
+        return model_string(get(*name));
     return {};
 }
 
-std::string read_type(Xml::Element object)
+std::pmr::string read_type(Xml::Element object)
 {
     if (auto type{optional_value(object, object_type)})
-        return std::string{get(*type)};
+        return model_string(get(*type));
     return {};
 }
 
@@ -474,8 +600,7 @@ Point read_position(Xml::Element object)
 
 Object::Polygon::Points read_points(Xml::Element poly)
 {
-    return transform<Object::Polygon::Points>(
-        tokenize(get(value(poly, object_polygon_points)), " "), to_point);
+    return to_points(get(value(poly, object_polygon_points)));
 }
 
 std::optional<Object::Shape> read_shape(Xml::Element object)
@@ -556,10 +681,19 @@ Object_layer::Objects read_objects(Xml::Element object_layer)
         object_layer.children(tmx_info::object), read_object);
 }
 
-Object_layer read_object_layer(Xml::Element object_layer)
+// Returns: The `Object_layer` without its objects.
+Object_layer read_object_layer_header(Xml::Element object_layer)
 {
     return {read_layer(object_layer), read_color(object_layer),
-            read_draw_order(object_layer), read_objects(object_layer)};
+            read_draw_order(object_layer),
+            model_container<Object_layer::Objects>()};
+}
+
+Object_layer read_object_layer(Xml::Element object_layer)
+{
+    auto layer{read_object_layer_header(object_layer)};
+    layer.objects = read_objects(object_layer);
+    return layer;
 }
 
 } // namespace object_layer
@@ -584,9 +718,9 @@ using image_layer::read_image_layer;
 
 namespace map {
 
-std::string read_version(Xml::Element map)
+std::pmr::string read_version(Xml::Element map)
 {
-    return std::string{get(value(map, map_version))};
+    return model_string(get(value(map, map_version)));
 }
 
 Map::Staggered::Axis read_axis(Xml::Element map)
@@ -664,20 +798,20 @@ Unique_id read_next_id(Xml::Element map)
 }
 
 Map::Tile_sets read_tile_sets(
-    Xml::Element map, const std::experimental::filesystem::path& tsx_base)
+    Xml::Element map, const Tsx_resolver& resolve_tsx)
 {
     return transform<Map::Tile_sets>(
         map.children(tmx_info::tile_set), [&](Xml::Element tile_set) {
-            return read_map_tile_set(tile_set, tsx_base);
+            return read_map_tile_set(tile_set, resolve_tsx);
         });
 }
 
-Map::Layer read_layer(Xml::Element layer)
+Map::Layer read_layer(Xml::Element layer, const Read_options& options)
 {
     auto name{layer.name()};
 
     if (name == tmx_info::tile_layer)
-        return read_tile_layer(layer);
+        return read_tile_layer(layer, options);
     if (name == tmx_info::object_layer)
         return read_object_layer(layer);
     if (name == tmx_info::image_layer)
@@ -686,41 +820,251 @@ Map::Layer read_layer(Xml::Element layer)
     throw Invalid_element{name};
 }
 
-Map::Layers read_layers(Xml::Element map)
+auto layers(Xml::Element map)
 {
-    return transform<Map::Layers>(
-        children(
-            map, {tmx_info::tile_layer, tmx_info::object_layer,
-                  tmx_info::image_layer}),
-        read_layer);
+    return children(
+        map,
+        {tmx_info::tile_layer, tmx_info::object_layer, tmx_info::image_layer});
 }
 
-Map read_map(
-    Xml::Element map, const std::experimental::filesystem::path& tsx_base)
+Map::Layers read_layers(Xml::Element map, const Read_options& options)
+{
+    return transform<Map::Layers>(layers(map), [&](Xml::Element layer) {
+        return read_layer(layer, options);
+    });
+}
+
+template <class Rng>
+std::vector<Xml::Element> to_vector(Rng elements)
+{
+    return transform<std::vector<Xml::Element>>(
+        std::move(elements), [](Xml::Element element) { return element; });
+}
+
+// Requires: Every element of `results` has a value.
+// Returns: The values of `results`.
+template <class Cont>
+Cont to_container(
+    std::vector<std::optional<typename Cont::value_type>>& results)
+{
+    auto container{model_container<Cont>()};
+    container.reserve(results.size());
+
+    for (auto& result : results)
+        container.push_back(std::move(*result));
+
+    return container;
+}
+
+// Returns: The `Map` without its tile sets and layers.
+Map read_map_header(Xml::Element map)
 {
     return {
         read_version(map), read_orientation(map), read_render_order(map),
         read_isize(map),   read_tile_size(map),   read_background(map),
-        read_next_id(map), read_properties(map),  read_tile_sets(map, tsx_base),
-        read_layers(map)};
+        read_next_id(map), read_properties(map),
+        model_container<Map::Tile_sets>(),
+        model_container<Map::Layers>()};
+}
+
+Map read_map(
+    Xml::Element map, const Tsx_resolver& resolve_tsx,
+    const Read_options& options)
+{
+    auto m{read_map_header(map)};
+
+    if (options.threads == 1) {
+        m.tile_sets = read_tile_sets(map, resolve_tsx);
+        m.layers    = read_layers(map, options);
+        return m;
+    }
+
+    // The tile sets, which may need loading a TSX, come first so that their
+    // I/O overlaps the reading of the layers.
+    const auto tile_set_elements{to_vector(map.children(tmx_info::tile_set))};
+    const auto layer_elements{to_vector(layers(map))};
+
+    std::vector<std::optional<Map::Tile_set>> tile_sets(
+        tile_set_elements.size());
+    std::vector<std::optional<Map::Layer>> read_layers(layer_elements.size());
+
+    parallel_for(
+        tile_sets.size() + read_layers.size(), options.threads,
+        [&, resource = Model_resource::get()](std::size_t i) {
+            const Model_resource::Use use{resource};
+
+            if (i < tile_sets.size())
+                tile_sets[i] =
+                    read_map_tile_set(tile_set_elements[i], resolve_tsx);
+            else {
+                i -= tile_sets.size();
+                read_layers[i] = read_layer(layer_elements[i], options);
+            }
+        });
+
+    m.tile_sets = to_container<Map::Tile_sets>(tile_sets);
+    m.layers    = to_container<Map::Layers>(read_layers);
+    return m;
+}
+
+void visit_object_layer(Xml::Element layer, const Tmx_callbacks& callbacks)
+{
+    auto header{object_layer::read_object_layer_header(layer)};
+
+    for (auto object : layer.children(tmx_info::object))
+        callbacks.object(header, read_object(object));
+
+    if (callbacks.layer)
+        callbacks.layer(std::move(header));
+}
+
+void read_map(
+    Xml::Element map, const Tsx_resolver& resolve_tsx,
+    const Tmx_callbacks& callbacks, const Read_options& options)
+{
+    if (callbacks.map)
+        callbacks.map(read_map_header(map));
+
+    if (callbacks.tile_set)
+        for (auto tile_set : map.children(tmx_info::tile_set))
+            callbacks.tile_set(read_map_tile_set(tile_set, resolve_tsx));
+
+    if (!callbacks.layer && !callbacks.object)
+        return;
+
+    for (auto layer : layers(map)) {
+        if (callbacks.select_layer &&
+            !callbacks.select_layer(layer::read_layer(layer)))
+            continue;
+
+        if (callbacks.object && layer.name() == tmx_info::object_layer)
+            visit_object_layer(layer, callbacks);
+        else if (callbacks.layer)
+            callbacks.layer(read_layer(layer, options));
+    }
 }
 
 } // namespace map
 
 using map::read_map;
 
+Xml::Element map_root(const Xml& tmx)
+{
+    auto map{tmx.root()};
+
+    if (map.name() == tmx_info::map)
+        return map;
+
+    throw Invalid_element{map.name()};
+}
+
+Map read_tmx(
+    const Xml& tmx, const Tsx_resolver& resolve_tsx,
+    const Read_options& options)
+{
+    const Model_resource::Use use{options.memory_resource};
+
+    return read_map(map_root(tmx), resolve_tsx, options);
+}
+
+void read_tmx(
+    const Xml& tmx, const Tsx_resolver& resolve_tsx,
+    const Tmx_callbacks& callbacks, const Read_options& options)
+{
+    const Model_resource::Use use{options.memory_resource};
+
+    read_map(map_root(tmx), resolve_tsx, callbacks, options);
+}
+
+// Returns: A `Tsx_resolver` of TSXs relative to the TMX `path`, which uses
+//          `options.tsx_cache` if any.
+Tsx_resolver tsx_resolver(
+    const std::experimental::filesystem::path& path,
+    const Read_options& options)
+{
+    if (options.tsx_cache)
+        return options.tsx_cache->resolver(path.parent_path());
+
+    return [base = path.parent_path()](Global_tile_id first_id, File tsx) {
+        return tmxpp::read_tsx(first_id, std::move(tsx), base);
+    };
+}
+
+Map::Tile_set read_tsx(const Xml& tsx, Global_tile_id first_id, File file)
+{
+    auto tile_set{tsx.root()};
+
+    if (tile_set.name() != tmx_info::tile_set)
+        throw Invalid_element{tile_set.name()};
+
+    if (tile_set::is_tile_set(tile_set))
+        return read_tile_set(tile_set, first_id, std::move(file));
+    return read_image_collection(tile_set, first_id, std::move(file));
+}
+
 } // namespace
 } // namespace impl
 
-Map read_tmx(const std::experimental::filesystem::path& path) try {
+Map read_tmx(
+    const std::experimental::filesystem::path& path,
+    const Read_options& options) try {
     const impl::Xml tmx{path.string().c_str()};
 
-    auto map{tmx.root()};
+    return impl::read_tmx(tmx, impl::tsx_resolver(path, options), options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+Map read_tmx(
+    Document tmx, const Tsx_resolver& resolve_tsx,
+    const Read_options& options) try {
+    return impl::read_tmx(
+        impl::Xml{impl::Xml::Text{get(tmx)}}, resolve_tsx, options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+Map read_tmx(
+    In_situ_document tmx, const Tsx_resolver& resolve_tsx,
+    const Read_options& options) try {
+    return impl::read_tmx(
+        impl::Xml{impl::Xml::In_situ_text{get(tmx)}}, resolve_tsx, options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+void read_tmx(
+    const std::experimental::filesystem::path& path,
+    const Tmx_callbacks& callbacks, const Read_options& options) try {
+    const impl::Xml tmx{path.string().c_str()};
+
+    impl::read_tmx(
+        tmx, impl::tsx_resolver(path, options), callbacks, options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
 
-    if (map.name() == impl::tmx_info::map)
-        return impl::read_map(map, path.parent_path());
+void read_tmx(
+    Document tmx, const Tmx_callbacks& callbacks,
+    const Tsx_resolver& resolve_tsx, const Read_options& options) try {
+    impl::read_tmx(
+        impl::Xml{impl::Xml::Text{get(tmx)}}, resolve_tsx, callbacks,
+        options);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
 
-    throw impl::Invalid_element{map.name()};
+void read_tmx(
+    In_situ_document tmx, const Tmx_callbacks& callbacks,
+    const Tsx_resolver& resolve_tsx, const Read_options& options) try {
+    impl::read_tmx(
+        impl::Xml{impl::Xml::In_situ_text{get(tmx)}}, resolve_tsx, callbacks,
+        options);
 }
 catch (const Invalid_argument& e) {
     throw Exception{e.what()};
@@ -731,14 +1075,26 @@ Map::Tile_set read_tsx(
     const std::experimental::filesystem::path& base) try {
     const impl::Xml xml{absolute(tsx, base).string().c_str()};
 
-    auto tile_set{xml.root()};
+    return impl::read_tsx(xml, first_id, std::move(tsx));
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
 
-    if (tile_set.name() != impl::tmx_info::tile_set)
-        throw impl::Invalid_element{tile_set.name()};
+Map::Tile_set read_tsx(
+    Global_tile_id first_id, File tsx, Document document) try {
+    return impl::read_tsx(
+        impl::Xml{impl::Xml::Text{get(document)}}, first_id, std::move(tsx));
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
 
-    if (impl::tile_set::is_tile_set(tile_set))
-        return impl::read_tile_set(tile_set, first_id, std::move(tsx));
-    return impl::read_image_collection(tile_set, first_id, std::move(tsx));
+Map::Tile_set read_tsx(
+    Global_tile_id first_id, File tsx, In_situ_document document) try {
+    return impl::read_tsx(
+        impl::Xml{impl::Xml::In_situ_text{get(document)}}, first_id,
+        std::move(tsx));
 }
 catch (const Invalid_argument& e) {
     throw Exception{e.what()};
@@ -777,4 +1133,615 @@ catch (const Invalid_argument& e) {
     throw Exception{e.what()};
 }
 
+struct Reader::Impl {
+    Impl(Read_options options, std::size_t tsx_cache_capacity)
+      : cache{tsx_cache_capacity}, options{options}
+    {
+        if (!this->options.tsx_cache)
+            this->options.tsx_cache = &cache;
+    }
+
+    template <class Text, class... Args>
+    auto read_tmx(Text text, const Tsx_resolver& resolve_tsx, Args&... args)
+    {
+        const impl::Block_recycler::Use use{recycler};
+        const auto clear{gsl::finally([this] { xml.clear(); })};
+
+        xml.load(text);
+
+        return impl::read_tmx(xml, resolve_tsx, args..., options);
+    }
+
+    Tsx_cache cache;
+    Read_options options;
+    impl::Block_recycler recycler; // Outlives the blocks of `xml`.
+    impl::Xml xml;
+};
+
+Reader::Reader(Read_options options, std::size_t tsx_cache_capacity)
+  : impl_{std::make_unique<Impl>(options, tsx_cache_capacity)}
+{
+}
+
+Reader::~Reader() = default;
+
+Map Reader::read_tmx(const std::experimental::filesystem::path& tmx) try {
+    return impl_->read_tmx(
+        tmx.string().c_str(), impl::tsx_resolver(tmx, impl_->options));
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+Map Reader::read_tmx(Document tmx, const Tsx_resolver& resolve_tsx) try {
+    return impl_->read_tmx(impl::Xml::Text{get(tmx)}, resolve_tsx);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+Map Reader::read_tmx(
+    In_situ_document tmx, const Tsx_resolver& resolve_tsx) try {
+    return impl_->read_tmx(impl::Xml::In_situ_text{get(tmx)}, resolve_tsx);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+void Reader::read_tmx(
+    const std::experimental::filesystem::path& tmx,
+    const Tmx_callbacks& callbacks) try {
+    impl_->read_tmx(
+        tmx.string().c_str(), impl::tsx_resolver(tmx, impl_->options),
+        callbacks);
+}
+catch (const Invalid_argument& e) {
+    throw Exception{e.what()};
+}
+
+Map::Tile_set Reader::read_tsx(
+    Global_tile_id first_id, File tsx,
+    const std::experimental::filesystem::path& base)
+{
+    return tsx_cache().read_tsx(first_id, std::move(tsx), base);
+}
+
+Tsx_cache& Reader::tsx_cache() noexcept
+{
+    return *impl_->options.tsx_cache;
+}
+
+void Reader::clear() noexcept
+{
+    impl_->xml.clear();
+    impl_->recycler.release();
+}
+
+namespace tmx {
+
+namespace impl {
+
+using tmxpp::impl::Xml;
+
+using namespace tmxpp::impl::tmx_info;
+
+// Constructs the views of a parsed document.
+struct View_access {
+    template <class View>
+    static View view(Xml::Element element) noexcept
+    {
+        return View{element.underlying()};
+    }
+
+    template <class View>
+    static std::optional<View> view(
+        std::optional<Xml::Element> element) noexcept
+    {
+        if (element)
+            return view<View>(*element);
+        return {};
+    }
+
+    // Returns: A range of the elements from `first`.
+    template <class T>
+    static Element_range<T> range(std::optional<Xml::Element> first) noexcept
+    {
+        return Element_range<T>{first ? first->underlying() : nullptr};
+    }
+
+    // Returns: A range of the children of `element` named `name`.
+    template <class T>
+    static Element_range<T> range(
+        Xml::Element element, Xml::Element::Name name) noexcept
+    {
+        return range<T>(element.optional_child(name));
+    }
+
+    // Returns: A range of the children of the child of `element` named
+    //          `parent`, which are named `name`.
+    template <class T>
+    static Element_range<T> range(
+        Xml::Element element, Xml::Element::Name parent,
+        Xml::Element::Name name) noexcept
+    {
+        if (auto p{element.optional_child(parent)})
+            return range<T>(*p, name);
+        return {};
+    }
+};
+
+namespace {
+
+Node* next_named(Node* node) noexcept
+{
+    const Xml::Element element{node};
+
+    if (auto next{element.next_sibling(element.name())})
+        return next->underlying();
+    return nullptr;
+}
+
+bool is_layer(Xml::Element element) noexcept
+{
+    const auto name{element.name()};
+
+    return name == tile_layer || name == object_layer || name == image_layer;
+}
+
+// Returns: `value`, or an empty view if there is no such value.
+std::string_view optional_string(
+    Xml::Element element, Xml::Attribute::Name name) noexcept
+{
+    if (auto value{tmxpp::impl::optional_value(element, name)})
+        return get(*value);
+    return {};
+}
+
+} // namespace
+
+template <>
+Property_view element<Property_view>(Node* node)
+{
+    return View_access::view<Property_view>(Xml::Element{node});
+}
+
+template <>
+Frame element<Frame>(Node* node)
+{
+    return tmxpp::impl::animation::read_frame(Xml::Element{node});
+}
+
+template <>
+Object_view element<Object_view>(Node* node)
+{
+    return View_access::view<Object_view>(Xml::Element{node});
+}
+
+template <>
+Tile_view element<Tile_view>(Node* node)
+{
+    return View_access::view<Tile_view>(Xml::Element{node});
+}
+
+template <>
+Tile_set_view element<Tile_set_view>(Node* node)
+{
+    return View_access::view<Tile_set_view>(Xml::Element{node});
+}
+
+template <>
+Map_view::Layer element<Map_view::Layer>(Node* node)
+{
+    const Xml::Element layer{node};
+    const auto name{layer.name()};
+
+    if (name == tile_layer)
+        return View_access::view<Tile_layer_view>(layer);
+    if (name == object_layer)
+        return View_access::view<Object_layer_view>(layer);
+    if (name == image_layer)
+        return View_access::view<Image_layer_view>(layer);
+
+    throw tmxpp::impl::Invalid_element{name};
+}
+
+template <>
+Node* next_element<Property_view>(Node* node) noexcept
+{
+    return next_named(node);
+}
+
+template <>
+Node* next_element<Frame>(Node* node) noexcept
+{
+    return next_named(node);
+}
+
+template <>
+Node* next_element<Object_view>(Node* node) noexcept
+{
+    return next_named(node);
+}
+
+template <>
+Node* next_element<Tile_view>(Node* node) noexcept
+{
+    return next_named(node);
+}
+
+template <>
+Node* next_element<Tile_set_view>(Node* node) noexcept
+{
+    return next_named(node);
+}
+
+template <>
+Node* next_element<Map_view::Layer>(Node* node) noexcept
+{
+    for (auto next{Xml::Element{node}.next_sibling()}; next;
+         next = next->next_sibling())
+        if (is_layer(*next))
+            return next->underlying();
+
+    return nullptr;
+}
+
+} // namespace impl
+
+namespace read = tmxpp::impl;
+
+using impl::View_access;
+using impl::optional_string;
+using Element = read::Xml::Element;
+using namespace read::tmx_info;
+
+// Property_view ---------------------------------------------------------------
+
+std::string_view Property_view::name() const
+{
+    return get(read::value(Element{node_}, property_name));
+}
+
+auto Property_view::value() const -> Value
+{
+    return read::properties::read_value_view(Element{node_});
+}
+
+// Image_view ------------------------------------------------------------------
+
+std::string_view Image_view::source() const
+{
+    return get(read::value(Element{node_}, image_source));
+}
+
+std::optional<Color> Image_view::transparent() const
+{
+    return read::image::read_transparent(Element{node_});
+}
+
+std::optional<pxSize> Image_view::size() const
+{
+    return read::read_optional_size(Element{node_});
+}
+
+// Object_view -----------------------------------------------------------------
+
+Unique_id Object_view::unique_id() const
+{
+    return read::object::read_unique_id(Element{node_});
+}
+
+std::string_view Object_view::name() const
+{
+    return optional_string(Element{node_}, object_name);
+}
+
+std::string_view Object_view::type() const
+{
+    return optional_string(Element{node_}, object_type);
+}
+
+Point Object_view::position() const
+{
+    return read::object::read_position(Element{node_});
+}
+
+std::optional<Object::Shape> Object_view::shape() const
+{
+    return read::object::read_shape(Element{node_});
+}
+
+Degrees Object_view::clockwise_rotation() const
+{
+    return read::object::read_clockwise_rotation(Element{node_});
+}
+
+std::optional<Global_tile_id> Object_view::global_id() const
+{
+    return read::object::read_global_id(Element{node_});
+}
+
+bool Object_view::visible() const
+{
+    return read::object::read_visible(Element{node_});
+}
+
+Properties_view Object_view::properties() const
+{
+    return View_access::range<Property_view>(
+        Element{node_}, read::tmx_info::properties, property);
+}
+
+// Layer_view ------------------------------------------------------------------
+
+std::string_view Layer_view::name() const
+{
+    return optional_string(Element{node_}, layer_name);
+}
+
+Unit_interval Layer_view::opacity() const
+{
+    return read::layer::read_opacity(Element{node_});
+}
+
+bool Layer_view::visible() const
+{
+    return read::layer::read_visible(Element{node_});
+}
+
+Offset Layer_view::offset() const
+{
+    return read::layer::read_offset(Element{node_});
+}
+
+Properties_view Layer_view::properties() const
+{
+    return View_access::range<Property_view>(
+        Element{node_}, read::tmx_info::properties, property);
+}
+
+// Tile_layer_view -------------------------------------------------------------
+
+iSize Tile_layer_view::size() const
+{
+    return read::read_isize(Element{node_});
+}
+
+Data::Format Tile_layer_view::format() const
+{
+    return read::data::read_format(Element{node_}.child(read::tmx_info::data));
+}
+
+std::string_view Tile_layer_view::data() const
+{
+    return get(Element{node_}.child(read::tmx_info::data).value());
+}
+
+Data::Flipped_ids Tile_layer_view::tile_ids() const
+{
+    return Data::Flipped_ids{
+        read::data::read_raw_ids(format(), data(), size())};
+}
+
+// Object_layer_view -----------------------------------------------------------
+
+std::optional<Color> Object_layer_view::color() const
+{
+    return read::object_layer::read_color(Element{node_});
+}
+
+Object_layer::Draw_order Object_layer_view::draw_order() const
+{
+    return read::object_layer::read_draw_order(Element{node_});
+}
+
+auto Object_layer_view::objects() const -> Objects
+{
+    return View_access::range<Object_view>(
+        Element{node_}, read::tmx_info::object);
+}
+
+// Image_layer_view ------------------------------------------------------------
+
+std::optional<Image_view> Image_layer_view::image() const
+{
+    return View_access::view<Image_view>(
+        Element{node_}.optional_child(read::tmx_info::image));
+}
+
+// Tile_view -------------------------------------------------------------------
+
+Local_tile_id Tile_view::id() const
+{
+    return read::tile_set::read_tile_id(Element{node_});
+}
+
+Properties_view Tile_view::properties() const
+{
+    return View_access::range<Property_view>(
+        Element{node_}, read::tmx_info::properties, property);
+}
+
+std::optional<Image_view> Tile_view::image() const
+{
+    return View_access::view<Image_view>(
+        Element{node_}.optional_child(read::tmx_info::image));
+}
+
+std::optional<Object_layer_view> Tile_view::collision_shape() const
+{
+    return View_access::view<Object_layer_view>(
+        Element{node_}.optional_child(object_layer));
+}
+
+Element_range<Frame> Tile_view::animation() const
+{
+    return View_access::range<Frame>(
+        Element{node_}, read::tmx_info::animation, frame);
+}
+
+// Tile_set_view ---------------------------------------------------------------
+
+Global_tile_id Tile_set_view::first_id() const
+{
+    return read::tile_set::read_first_id(Element{node_});
+}
+
+File_view Tile_set_view::tsx() const
+{
+    return File_view{optional_string(Element{node_}, tile_set_tsx)};
+}
+
+std::string_view Tile_set_view::name() const
+{
+    return optional_string(Element{node_}, tile_set_name);
+}
+
+pxSize Tile_set_view::tile_size() const
+{
+    return read::read_tile_size(Element{node_});
+}
+
+Non_negative<Pixels> Tile_set_view::spacing() const
+{
+    return read::tile_set::tile_set::read_spacing(Element{node_});
+}
+
+Non_negative<Pixels> Tile_set_view::margin() const
+{
+    return read::tile_set::tile_set::read_margin(Element{node_});
+}
+
+Non_negative<int> Tile_set_view::tile_count() const
+{
+    return read::tile_set::read_tile_count(Element{node_});
+}
+
+Non_negative<int> Tile_set_view::columns() const
+{
+    return read::tile_set::read_columns(Element{node_});
+}
+
+Offset Tile_set_view::tile_offset() const
+{
+    return read::tile_set::read_tile_offset(Element{node_});
+}
+
+Properties_view Tile_set_view::properties() const
+{
+    return View_access::range<Property_view>(
+        Element{node_}, read::tmx_info::properties, property);
+}
+
+std::optional<Image_view> Tile_set_view::image() const
+{
+    return View_access::view<Image_view>(
+        Element{node_}.optional_child(read::tmx_info::image));
+}
+
+auto Tile_set_view::tiles() const -> Tiles
+{
+    return View_access::range<Tile_view>(Element{node_}, tile_set_tile);
+}
+
+// Map_view --------------------------------------------------------------------
+
+std::string_view Map_view::version() const
+{
+    return get(read::value(Element{node_}, map_version));
+}
+
+Map::Orientation Map_view::orientation() const
+{
+    return read::map::read_orientation(Element{node_});
+}
+
+Map::Render_order Map_view::render_order() const
+{
+    return read::map::read_render_order(Element{node_});
+}
+
+iSize Map_view::size() const
+{
+    return read::read_isize(Element{node_});
+}
+
+pxSize Map_view::general_tile_size() const
+{
+    return read::read_tile_size(Element{node_});
+}
+
+std::optional<Color> Map_view::background() const
+{
+    return read::map::read_background(Element{node_});
+}
+
+Unique_id Map_view::next_id() const
+{
+    return read::map::read_next_id(Element{node_});
+}
+
+Properties_view Map_view::properties() const
+{
+    return View_access::range<Property_view>(
+        Element{node_}, read::tmx_info::properties, property);
+}
+
+auto Map_view::tile_sets() const -> Tile_sets
+{
+    return View_access::range<Tile_set_view>(Element{node_}, tile_set);
+}
+
+auto Map_view::layers() const -> Layers
+{
+    auto layers{read::map::layers(Element{node_})};
+    auto first{ranges::begin(layers)};
+
+    if (first == ranges::end(layers))
+        return {};
+    return View_access::range<Layer>(*first);
+}
+
+// Loaded_document -------------------------------------------------------------
+
+Loaded_document::Loaded_document(
+    const std::experimental::filesystem::path& path)
+  : xml_{std::make_unique<read::Xml>(path.string().c_str())}
+{
+}
+
+Loaded_document::Loaded_document(Document document)
+  : xml_{std::make_unique<read::Xml>(read::Xml::Text{get(document)})}
+{
+}
+
+Loaded_document::Loaded_document(In_situ_document document)
+  : xml_{
+        std::make_unique<read::Xml>(read::Xml::In_situ_text{get(document)})}
+{
+}
+
+Loaded_document::Loaded_document(Loaded_document&&) noexcept = default;
+Loaded_document& Loaded_document::operator=(Loaded_document&&) noexcept =
+    default;
+
+Loaded_document::~Loaded_document() = default;
+
+Map_view Loaded_document::map() const
+{
+    return View_access::view<Map_view>(read::map_root(*xml_));
+}
+
+Tile_set_view Loaded_document::tile_set() const
+{
+    const auto root{xml_->root()};
+
+    if (root.name() != read::tmx_info::tile_set)
+        throw read::Invalid_element{root.name()};
+
+    return View_access::view<Tile_set_view>(root);
+}
+
+} // namespace tmx
+
 } // namespace tmxpp
@@ -1,11 +1,15 @@
-#include <fstream>
+#include <list>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <variant>
 #include <boost/hana/functional/overload.hpp>
 #include <tmxpp.hpp>
 #include <tmxpp/exceptions.hpp>
+#include <tmxpp/impl/Output_file.hpp>
 #include <tmxpp/impl/Xml.hpp>
+#include <tmxpp/impl/Xml_writer.hpp>
 #include <tmxpp/impl/exceptions.hpp>
 #include <tmxpp/impl/tmx_info.hpp>
 #include <tmxpp/impl/to_string_flipped_ids.hpp>
@@ -19,13 +23,13 @@ namespace impl {
 using namespace tmx_info;
 
 template <class Number>
-void write(Size<Number> sz, Xml::Element elem)
+void write(Size<Number> sz, Xml_writer::Element elem)
 {
     add(elem, size_width, sz.w);
     add(elem, size_height, sz.h);
 }
 
-void write_tile(pxSize sz, Xml::Element elem)
+void write_tile(pxSize sz, Xml_writer::Element elem)
 {
     add(elem, tile_size_width, sz.w);
     add(elem, tile_size_height, sz.h);
@@ -33,7 +37,7 @@ void write_tile(pxSize sz, Xml::Element elem)
 
 // Properties ------------------------------------------------------------------
 
-void write(const Property::Value& value, Xml::Element prop)
+void write(const Property::Value& value, Xml_writer::Element prop)
 {
     auto add = [=](Xml::Attribute::Value alternative, auto value) {
         prop.add(property_alternative, alternative);
@@ -43,31 +47,29 @@ void write(const Property::Value& value, Xml::Element prop)
     std::visit(
         boost::hana::overload(
             [=](int i) { add(property_alternative_int, i); },
-            [=](double d) {
-                add(property_alternative_double, to_string<double>(d));
-            },
+            [=](double d) { add(property_alternative_double, d); },
             [=](bool b) {
                 add(property_alternative_bool,
                     get(b ? property_value_true : property_value_false));
             },
             [=](Color c) { add(property_alternative_color, c); },
             [=](File f) { add(property_alternative_file, f.string()); },
-            [=](const std::string& s) {
-                if (bool is_multiline{s.find('\n') != std::string::npos})
-                    prop.value(Xml::Element::Value{s});
+            [=](const std::pmr::string& s) {
+                if (bool is_multiline{s.find('\n') != s.npos})
+                    prop.value(Xml_writer::Element::Value{s});
                 else
                     impl::add(prop, property_value, s);
             }),
         value);
 }
 
-void write(const Property& p, Xml::Element elem)
+void write(const Property& p, Xml_writer::Element elem)
 {
     add(elem, property_name, p.name);
     write(p.value, elem);
 }
 
-void write(const Properties& ps, Xml::Element parent)
+void write(const Properties& ps, Xml_writer::Element parent)
 {
     if (ps.empty())
         return;
@@ -80,7 +82,7 @@ void write(const Properties& ps, Xml::Element parent)
 
 // Image -----------------------------------------------------------------------
 
-void write(const Image& img, Xml::Element elem)
+void write(const Image& img, Xml_writer::Element elem)
 {
     add(elem, image_source, img.source.string());
     add(elem, image_transparent, img.transparent);
@@ -89,13 +91,13 @@ void write(const Image& img, Xml::Element elem)
 
 // Animation -------------------------------------------------------------------
 
-void write(Frame f, Xml::Element elem)
+void write(Frame f, Xml_writer::Element elem)
 {
     add(elem, frame_id, f.id);
     add(elem, frame_duration, f.duration->count());
 }
 
-void write(const Animation& anim, Xml::Element tile)
+void write(const Animation& anim, Xml_writer::Element tile)
 {
     if (anim.empty())
         return;
@@ -108,7 +110,7 @@ void write(const Animation& anim, Xml::Element tile)
 
 // Map::Tile_set ---------------------------------------------------------------
 
-void write_tile(Offset o, Xml::Element tset)
+void write_tile(Offset o, Xml_writer::Element tset)
 {
     if (o == Offset{})
         return;
@@ -119,13 +121,13 @@ void write_tile(Offset o, Xml::Element tset)
     add(elem, tile_offset_y, o.y);
 }
 
-void write(const Object_layer& l, Xml::Element elem);
+void write(const Object_layer& l, Xml_writer::Element elem);
 
 template <class Tile>
 std::enable_if_t<
     std::is_same_v<Tile, Tile_set::Tile> ||
     std::is_same_v<Tile, Image_collection::Tile>>
-write(const Tile& tile, Xml::Element elem)
+write(const Tile& tile, Xml_writer::Element elem)
 {
     add(elem, tile_set_tile_id, tile.id);
     write(tile.properties, elem);
@@ -142,7 +144,7 @@ template <class Tiles>
 std::enable_if_t<
     std::is_same_v<Tiles, Tile_set::Tiles> ||
     std::is_same_v<Tiles, Image_collection::Tiles>>
-write(const Tiles& ts, Xml::Element tset)
+write(const Tiles& ts, Xml_writer::Element tset)
 {
     for (const auto& t : ts)
         write(t, tset.add(tile_set_tile));
@@ -150,10 +152,25 @@ write(const Tiles& ts, Xml::Element tset)
 
 enum class Tile_set_type : unsigned char { unknown, tsx };
 
+// Effects: Writes `ts` as a TSX document to `sink`.
+template <class Tile_set_>
+void write_tsx(const Tile_set_& ts, const Sink& sink);
+
+// Returns: The `Sink` of the external tile set `tsx`.
+// Throws: `Exception` if `resolve_sink` is empty.
+Sink resolve(const Tsx_sink_resolver& resolve_sink, const File& tsx)
+{
+    if (!resolve_sink)
+        throw Exception{
+            "No sink for the external tile set " + tsx.string() + '.'};
+
+    return resolve_sink(tsx);
+}
+
 template <class Tset>
 void map_tile_set_visitor(
-    const Tset& ts, Xml::Element elem, Tile_set_type type,
-    const std::experimental::filesystem::path& tsx_base = {})
+    const Tset& ts, Xml_writer::Element elem, Tile_set_type type,
+    const Tsx_sink_resolver& resolve_sink = {})
 {
     if (type != Tile_set_type::tsx) {
         add(elem, tile_set_first_id, ts.first_id);
@@ -161,7 +178,7 @@ void map_tile_set_visitor(
     }
 
     if (bool is_external{type == Tile_set_type::unknown && !ts.tsx.empty()})
-        return tmxpp::write(ts, tsx_base);
+        return write_tsx(ts, resolve(resolve_sink, ts.tsx));
 
     add(elem, tile_set_name, ts.name);
     // clang-format off
@@ -189,25 +206,46 @@ template <class Tile_set_>
 std::enable_if_t<
     std::is_same_v<Tile_set_, Tile_set> ||
     std::is_same_v<Tile_set_, Image_collection>>
-write(const Tile_set_& ts, Xml::Element elem, Tile_set_type type)
+write(const Tile_set_& ts, Xml_writer::Element elem, Tile_set_type type)
 {
     map_tile_set_visitor(ts, elem, type);
 }
 
 void write(
-    const Map::Tile_set& ts, Xml::Element elem, Tile_set_type type,
-    const std::experimental::filesystem::path& tsx_base = {})
+    const Map::Tile_set& ts, Xml_writer::Element elem, Tile_set_type type,
+    const Tsx_sink_resolver& resolve_sink = {})
 {
     std::visit(
-        [elem, type, &tsx_base](const auto& ts) {
-            map_tile_set_visitor(ts, elem, type, tsx_base);
+        [elem, type, &resolve_sink](const auto& ts) {
+            map_tile_set_visitor(ts, elem, type, resolve_sink);
         },
         ts);
 }
 
+template <class Tile_set_>
+void write_tsx(const Tile_set_& ts, const Sink& sink)
+{
+    Xml_writer tsx{sink, tile_set};
+
+    write(ts, tsx.root(), Tile_set_type::tsx);
+
+    tsx.finish();
+}
+
+const File& tsx(const Map::Tile_set& ts) noexcept
+{
+    return std::visit([](const auto& ts) -> const File& { return ts.tsx; }, ts);
+}
+
+template <class Tile_set_>
+const File& tsx(const Tile_set_& ts) noexcept
+{
+    return ts.tsx;
+}
+
 // Data ------------------------------------------------------------------------
 
-void write(Data::Encoding e, Xml::Element data)
+void write(Data::Encoding e, Xml_writer::Element data)
 {
     data.add(data_encoding, [e] {
         switch (e) {
@@ -218,7 +256,7 @@ void write(Data::Encoding e, Xml::Element data)
     }());
 }
 
-void write(Data::Compression c, Xml::Element data)
+void write(Data::Compression c, Xml_writer::Element data)
 {
     if (c == Data::Compression::none)
         return;
@@ -226,54 +264,64 @@ void write(Data::Compression c, Xml::Element data)
     data.add(data_compression, [c] {
         switch (c) {
         case Data::Compression::zlib: return data_compression_zlib;
+        case Data::Compression::gzip: return data_compression_gzip;
+        case Data::Compression::zstd: return data_compression_zstd;
         default: throw Invalid_enum{"Invalid Data::Compression.", c};
         }
     }());
 }
 
-void write(Data::Format f, Xml::Element data)
+void write(Data::Format f, Xml_writer::Element data)
 {
     write(f.encoding(), data);
     write(f.compression(), data);
 }
 
-void write(const Data& d, Xml::Element elem, iSize size)
+void write(const Data& d, Xml_writer::Element elem, iSize size)
 {
-    if (d.format != Data::Encoding::csv)
-        throw Exception{"Can only handle csv-encoded data."};
-
     write(d.format, elem);
-    elem.value(to_string(d.ids, size));
+    elem.value(Xml_writer::Element::Value{
+        d.format == Data::Encoding::csv
+            ? to_string(d.ids, size)
+            : to_base64(d.ids, size, d.format.compression())});
 }
 
 // Object ----------------------------------------------------------------------
 
-void write(Point p, Xml::Element obj)
+void write(Point p, Xml_writer::Element obj)
 {
     add(obj, point_x, p.x);
     add(obj, point_y, p.y);
 }
 
-void write_object(pxSize sz, Xml::Element obj)
+void write_object(pxSize sz, Xml_writer::Element obj)
 {
     non_default_add(obj, size_width, sz.w);
     non_default_add(obj, size_height, sz.h);
 }
 
-void write(const Object::Shape& s, Xml::Element obj)
+void write(const Object::Shape& s, Xml_writer::Element obj)
 {
     std::visit(
         boost::hana::overload(
             [obj](Object::Rectangle r) { write_object(r.size, obj); },
-            [obj](Object::Ellipse e) {
-                write_object(e.size, obj);
-                obj.add(object_ellipse);
-            },
+            [obj](Object::Ellipse e) { write_object(e.size, obj); },
+            [](const auto&) {}),
+        s);
+}
+
+// Effects: Adds the child `Element` of `s`, if any.
+void write_child(const Object::Shape& s, Xml_writer::Element obj)
+{
+    std::visit(
+        boost::hana::overload(
+            [](Object::Rectangle) {},
+            [obj](Object::Ellipse) { obj.add(object_ellipse); },
             [obj](const auto& poly) { write(poly, obj); }),
         s);
 }
 
-void write(const Object& obj, Xml::Element elem)
+void write(const Object& obj, Xml_writer::Element elem)
 {
     add(elem, object_unique_id, obj.unique_id);
     non_empty_add(elem, object_name, obj.name);
@@ -285,11 +333,13 @@ void write(const Object& obj, Xml::Element elem)
     if (!obj.visible)
         add(elem, object_visible, "0");
     write(obj.properties, elem);
+    if (obj.shape)
+        write_child(*obj.shape, elem);
 }
 
 // Map::Layer ------------------------------------------------------------------
 
-void write(Object_layer::Draw_order do_, Xml::Element layer)
+void write(Object_layer::Draw_order do_, Xml_writer::Element layer)
 {
     if (do_ == Object_layer::Draw_order::top_down)
         return;
@@ -303,7 +353,7 @@ void write(Object_layer::Draw_order do_, Xml::Element layer)
     }());
 }
 
-void write(Offset o, Xml::Element layer)
+void write(Offset o, Xml_writer::Element layer)
 {
     if (o == Offset{})
         return;
@@ -312,14 +362,14 @@ void write(Offset o, Xml::Element layer)
     add(layer, offset_y, o.y);
 }
 
-void write(const Object_layer::Objects& objs, Xml::Element elem)
+void write(const Object_layer::Objects& objs, Xml_writer::Element elem)
 {
     for (const auto& obj : objs)
         write(obj, elem.add(object));
 }
 
 template <class Layer>
-void layer_visitor(const Layer& l, Xml::Element elem)
+void layer_visitor(const Layer& l, Xml_writer::Element elem)
 {
     // clang-format off
     if constexpr (std::is_same_v<Layer, Object_layer>) {
@@ -344,12 +394,12 @@ void layer_visitor(const Layer& l, Xml::Element elem)
     // clang-format on
 }
 
-void write(const Object_layer& l, Xml::Element elem)
+void write(const Object_layer& l, Xml_writer::Element elem)
 {
     layer_visitor(l, elem);
 }
 
-void write(const Map::Layer& l, Xml::Element map)
+void write(const Map::Layer& l, Xml_writer::Element map)
 {
     std::visit(
         [map](const auto& l) {
@@ -372,7 +422,7 @@ void write(const Map::Layer& l, Xml::Element map)
 
 // Map -------------------------------------------------------------------------
 
-void write(Map::Render_order ro, Xml::Element map)
+void write(Map::Render_order ro, Xml_writer::Element map)
 {
     map.add(map_render_order, [ro] {
         switch (ro) {
@@ -385,7 +435,7 @@ void write(Map::Render_order ro, Xml::Element map)
     }());
 }
 
-void write(Map::Staggered::Axis a, Xml::Element map)
+void write(Map::Staggered::Axis a, Xml_writer::Element map)
 {
     map.add(map_staggered_axis, [a] {
         switch (a) {
@@ -396,7 +446,7 @@ void write(Map::Staggered::Axis a, Xml::Element map)
     }());
 }
 
-void write(Map::Staggered::Index i, Xml::Element map)
+void write(Map::Staggered::Index i, Xml_writer::Element map)
 {
     map.add(map_staggered_index, [i] {
         switch (i) {
@@ -407,20 +457,21 @@ void write(Map::Staggered::Index i, Xml::Element map)
     }());
 }
 
-void write(Map::Staggered s, Xml::Element map)
+void write(Map::Staggered s, Xml_writer::Element map)
 {
     write(s.axis, map);
     write(s.index, map);
 }
 
-void write(Map::Hexagonal h, Xml::Element map)
+void write(Map::Hexagonal h, Xml_writer::Element map)
 {
     add(map, map_hexagonal_side_legth, h.side_length);
     write(static_cast<Map::Staggered>(h), map);
 }
 
 void write(
-    Map::Orientation orient, Map::Render_order render_order, Xml::Element map)
+    Map::Orientation orient, Map::Render_order render_order,
+    Xml_writer::Element map)
 {
     auto add = [=](Xml::Attribute::Value orient) {
         map.add(map_orientation, orient);
@@ -444,22 +495,22 @@ void write(
 }
 
 void write(
-    const Map::Tile_sets& tses, Xml::Element map,
-    const std::experimental::filesystem::path& tsx_base)
+    const Map::Tile_sets& tses, Xml_writer::Element map,
+    const Tsx_sink_resolver& resolve_sink)
 {
     for (const auto& ts : tses)
-        write(ts, map.add(tile_set), Tile_set_type::unknown, tsx_base);
+        write(ts, map.add(tile_set), Tile_set_type::unknown, resolve_sink);
 }
 
-void write(const Map::Layers& ls, Xml::Element map)
+void write(const Map::Layers& ls, Xml_writer::Element map)
 {
     for (const auto& l : ls)
         write(l, map);
 }
 
 void write(
-    const Map& map, Xml::Element elem,
-    const std::experimental::filesystem::path& tsx_base)
+    const Map& map, Xml_writer::Element elem,
+    const Tsx_sink_resolver& resolve_sink)
 {
     add(elem, map_version, map.version);
     write(map.orientation, map.render_order, elem);
@@ -468,29 +519,73 @@ void write(
     add(elem, map_background, map.background);
     add(elem, map_next_id, map.next_id);
     write(map.properties, elem);
-    write(map.tile_sets, elem, tsx_base);
+    write(map.tile_sets, elem, resolve_sink);
     write(map.layers, elem);
 }
 
-void write(const Xml& xml, const std::experimental::filesystem::path& out)
+// Returns: A `Sink` which writes to `os`, and throws `Exception` if it could
+//          not.
+Sink stream_sink(std::ostream& os)
 {
-    std::ofstream ofs{out};
+    return [&os](std::string_view chunk) {
+        os.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
 
-    if (!ofs)
-        throw Exception{"Output path " + out.string() + " presented problems."};
+        if (!os)
+            throw Exception{"Could not write to the output stream."};
+    };
+}
 
-    ofs << xml;
+// Returns: A `Sink` which appends to `s`.
+Sink string_sink(std::string& s)
+{
+    return [&s](std::string_view chunk) { s.append(chunk); };
 }
 
 } // namespace impl
 
 void write(const Map& map, const std::experimental::filesystem::path& path)
 {
-    impl::Xml tmx{impl::map};
+    impl::Output_file tmx{path};
+    std::list<impl::Output_file> tsxs;
 
-    impl::write(map, tmx.root(), path.parent_path());
+    write(
+        map, tmx.sink(), [&tsxs, base = path.parent_path()](const File& tsx) {
+            return tsxs.emplace_back(absolute(tsx, base)).sink();
+        });
 
-    write(tmx, path);
+    // The files are replaced only once all of them have been written.
+    tmx.close();
+    for (auto& tsx : tsxs)
+        tsx.close();
+
+    for (auto& tsx : tsxs)
+        tsx.commit();
+    tmx.commit();
+}
+
+void write(
+    const Map& map, const Sink& sink, const Tsx_sink_resolver& resolve_sink)
+{
+    impl::Xml_writer tmx{sink, impl::map};
+
+    impl::write(map, tmx.root(), resolve_sink);
+
+    tmx.finish();
+}
+
+void write(
+    const Map& map, std::ostream& os, const Tsx_sink_resolver& resolve_sink)
+{
+    write(map, impl::stream_sink(os), resolve_sink);
+}
+
+std::string to_tmx(const Map& map, const Tsx_sink_resolver& resolve_sink)
+{
+    std::string tmx;
+
+    write(map, impl::string_sink(tmx), resolve_sink);
+
+    return tmx;
 }
 
 template <class Tile_set_>
@@ -500,15 +595,67 @@ std::enable_if_t<
     std::is_same_v<Tile_set_, Image_collection>>
 write(const Tile_set_& ts, const std::experimental::filesystem::path& base)
 {
-    if (ts.tsx.empty())
+    if (impl::tsx(ts).empty())
         throw Exception{
             "Writing an external tile set requires a non-empty tsx."};
 
-    impl::Xml tsx{impl::tile_set};
+    impl::Output_file tsx{absolute(impl::tsx(ts), base)};
 
-    impl::write(ts, tsx.root(), impl::Tile_set_type::tsx);
+    write(ts, tsx.sink());
+    tsx.finish();
+}
 
-    write(tsx, absolute(ts.tsx, base));
+template <class Tile_set_>
+std::enable_if_t<
+    std::is_same_v<Tile_set_, Map::Tile_set> ||
+    std::is_same_v<Tile_set_, Tile_set> ||
+    std::is_same_v<Tile_set_, Image_collection>>
+write(const Tile_set_& ts, const Sink& sink)
+{
+    impl::write_tsx(ts, sink);
 }
 
+template <class Tile_set_>
+std::enable_if_t<
+    std::is_same_v<Tile_set_, Map::Tile_set> ||
+    std::is_same_v<Tile_set_, Tile_set> ||
+    std::is_same_v<Tile_set_, Image_collection>>
+write(const Tile_set_& ts, std::ostream& os)
+{
+    impl::write_tsx(ts, impl::stream_sink(os));
+}
+
+template <class Tile_set_>
+std::enable_if_t<
+    std::is_same_v<Tile_set_, Map::Tile_set> ||
+    std::is_same_v<Tile_set_, Tile_set> ||
+    std::is_same_v<Tile_set_, Image_collection>,
+    std::string>
+to_tsx(const Tile_set_& ts)
+{
+    std::string tsx;
+
+    impl::write_tsx(ts, impl::string_sink(tsx));
+
+    return tsx;
+}
+
+template void
+write(const Map::Tile_set&, const std::experimental::filesystem::path&);
+template void write(const Map::Tile_set&, const Sink&);
+template void write(const Map::Tile_set&, std::ostream&);
+template std::string to_tsx(const Map::Tile_set&);
+
+template void
+write(const Tile_set&, const std::experimental::filesystem::path&);
+template void write(const Tile_set&, const Sink&);
+template void write(const Tile_set&, std::ostream&);
+template std::string to_tsx(const Tile_set&);
+
+template void
+write(const Image_collection&, const std::experimental::filesystem::path&);
+template void write(const Image_collection&, const Sink&);
+template void write(const Image_collection&, std::ostream&);
+template std::string to_tsx(const Image_collection&);
+
 } // namespace tmxpp